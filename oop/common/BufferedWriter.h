@@ -0,0 +1,168 @@
+#ifndef BUFFEREDWRITER_H
+#define BUFFEREDWRITER_H
+// Header-only large-buffer output sink shared by the coursework programs.
+//
+// Numbers are formatted with std::to_chars straight into the buffer, and
+// the buffer is handed to fwrite only when full, so output cost is
+// dominated by I/O rather than by formatting or per-line flushes.
+#include <charconv>                                 // For std::to_chars
+#include <cmath>                                    // For fabs
+#include <cstdint>                                  // Fixed-width integers
+#include <cstdio>                                   // For std::FILE
+#include <cstring>                                  // For memcpy
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class BufferedWriter {
+public:
+    // Write to `path`, or to stdout when path is "-"
+    explicit BufferedWriter(const std::string& path, std::size_t capacity = 1 << 20)
+        : out(path == "-" ? stdout : std::fopen(path.c_str(), "wb")),
+          owned(path != "-"),
+          buf(capacity < 64 ? 64 : capacity) {
+        if (!out) throw std::runtime_error("Cannot open " + path + " for writing");
+    }
+    ~BufferedWriter() {                        // Flushes and closes
+        try { flush(); } catch (...) {}        // Destructors must not throw
+        if (owned) std::fclose(out);
+        else       std::fflush(out);
+    }
+
+    BufferedWriter(const BufferedWriter&) = delete;
+    BufferedWriter& operator=(const BufferedWriter&) = delete;
+
+    // One character
+    void put(char c) {
+        reserve(1);
+        buf[used++] = c;
+    }
+    // Raw bytes
+    void put(const char* s, std::size_t n) {
+        reserve(n);
+        std::memcpy(&buf[used], s, n);
+        used += n;
+    }
+    void put(std::string_view s) { put(s.data(), s.size()); }
+    void put(const std::string& s) { put(s.data(), s.size()); }
+    template <std::size_t N>                   // String literal, no strlen
+    void put(const char (&s)[N]) { put(s, N - 1); }
+
+    // Shortest round-trip decimal
+    void number(double v) {
+        reserve(32);                           // Longest double is 24 chars
+        auto res = std::to_chars(&buf[used], &buf[used] + 32, v);
+        used = res.ptr - buf.data();
+    }
+    // `precision` significant digits, as printf("%g") and ostream's default
+    void number(double v, int precision) {
+        reserve(64);
+        char* p = &buf[used];
+        std::size_t n = plainG(v, precision, p);
+        if (n == 0)
+            n = std::to_chars(p, p + 64, v, std::chars_format::general, precision).ptr - p;
+        used += n;
+    }
+    void number(long long v) {
+        reserve(24);
+        auto res = std::to_chars(&buf[used], &buf[used] + 24, v);
+        used = res.ptr - buf.data();
+    }
+    void number(unsigned long long v) {
+        reserve(24);
+        auto res = std::to_chars(&buf[used], &buf[used] + 24, v);
+        used = res.ptr - buf.data();
+    }
+
+    // Little-endian binary fields
+    void u32le(std::uint32_t v) {
+        char b[4];
+        for (int i = 0; i < 4; ++i) b[i] = (char)(v >> (8 * i));
+        put(b, 4);
+    }
+    void u64le(std::uint64_t v) {
+        char b[8];
+        for (int i = 0; i < 8; ++i) b[i] = (char)(v >> (8 * i));
+        put(b, 8);
+    }
+    void f64le(double v) {
+        std::uint64_t bits;
+        std::memcpy(&bits, &v, sizeof bits);   // IEEE-754 bit pattern
+        u64le(bits);
+    }
+    // u32le length, then bytes
+    void str(const std::string& s) {
+        u32le((std::uint32_t)s.size());
+        put(s);
+    }
+
+    // Push the buffer to the file
+    void flush() {
+        if (used && std::fwrite(buf.data(), 1, used, out) != used)
+            throw std::runtime_error("Write failed");
+        used = 0;
+    }
+
+private:
+    // %g for the common case of a plain decimal (1e-4 <= |v| < 10^precision)
+    // by one exact scaling and integer rounding, several times faster than
+    // to_chars. Returns 0, for the caller to use to_chars, outside that range
+    // or when v lies too close to a rounding tie for the product to decide.
+    static std::size_t plainG(double v, int precision, char* out) {
+        static const double kPow10[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10,
+                                        1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19};
+        static const double kTenths[] = {1e-4, 1e-3, 1e-2, 1e-1};
+        if (precision < 1 || precision > 15) return 0;
+        double a = v < 0 ? -v : v;
+        if (!(a >= 1e-4 && a < kPow10[precision])) return 0; // NaN fails too
+        int e;                                 // Decimal exponent: 10^e <= a < 10^(e+1)
+        if (a >= 1) {
+            e = 0;
+            while (a >= kPow10[e + 1]) ++e;
+        } else {
+            e = -4;
+            while (e < -1 && a >= kTenths[e + 5]) ++e;
+        }
+        double scaled = a * kPow10[precision - 1 - e]; // Exact powers up to 1e18
+        unsigned long long whole = (unsigned long long)scaled; // Below 1e15: no overflow
+        double frac = scaled - (double)whole;
+        if (std::fabs(frac - 0.5) <= scaled * 1e-15) return 0;
+        unsigned long long digits = whole + (frac > 0.5);
+        unsigned long long low = (unsigned long long)kPow10[precision - 1];
+        if (digits < low) return 0;            // Exponent guess off by one
+        if (digits >= low * 10) {              // 9.999995 -> 10.0000
+            digits /= 10;
+            if (++e >= precision) return 0;    // Needs the exponent form
+        }
+        char d[16];
+        for (int i = precision - 1; i >= 0; --i, digits /= 10) d[i] = char('0' + digits % 10);
+        int last = precision - 1;              // Drop trailing zeros of the fraction
+        int point = e >= 0 ? e : -1;           // Digits before the point - 1
+        while (last > point && d[last] == '0') --last;
+        std::size_t n = 0;
+        if (v < 0) out[n++] = '-';
+        if (e < 0) {
+            out[n++] = '0';
+            out[n++] = '.';
+            for (int z = -1; z > e; --z) out[n++] = '0';
+        }
+        for (int i = 0; i <= last; ++i) {
+            out[n++] = d[i];
+            if (i == e && i < last) out[n++] = '.';
+        }
+        return n;
+    }
+
+    // Make room for n more bytes
+    void reserve(std::size_t n) {
+        if (used + n > buf.size()) flush();
+        if (n > buf.size()) buf.resize(n);     // Oversized single write
+    }
+
+    std::FILE* out;
+    bool owned;                                // Close on destruction?
+    std::vector<char> buf;
+    std::size_t used = 0;
+};
+#endif // BUFFEREDWRITER_H
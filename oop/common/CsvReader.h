@@ -0,0 +1,400 @@
+#ifndef CSVREADER_H
+#define CSVREADER_H
+// Header-only CSV reader shared by the coursework loaders.
+//
+//   csv::Reader in("prices.csv");
+//   csv::Header header = in.readHeader();            // 1+ header lines
+//   auto rows = csv::mapping(csv::column("Date",  &Entry::date),
+//                            csv::column("Close", &Entry::close));
+//   rows.bind(header);                               // Names -> indices
+//   Entry e;
+//   while (in.next())
+//       if (rows.read(in, e)) entries.push_back(e);
+//
+// The file is read in large blocks and each record is split in place into
+// std::string_view cells, so a row costs no allocation. Views stay valid
+// until the next call to next(). Quoted fields may contain the delimiter,
+// line breaks and doubled quotes ("" is unescaped in place). A trailing
+// '\r' is dropped and blank lines are skipped.
+//
+// For parallel parsing, a Reader can be limited to a byte range of the
+// file; csv::splitLines cuts the data part of a file into such ranges at
+// line starts (this assumes no quoted field spans lines).
+#include <charconv>                                 // For std::from_chars
+#include <cstdint>                                  // For uint64_t
+#include <cstdio>                                   // For std::FILE
+#include <cstring>                                  // For memchr, memmove
+#include <stdexcept>                                // For std::runtime_error
+#include <string>
+#include <string_view>
+#include <tuple>                                    // Column list of a mapping
+#include <type_traits>                              // For is_arithmetic
+#include <utility>                                  // For std::move
+#include <vector>
+
+namespace csv {
+
+// ---------------------------------------------------------------- parsing
+
+// Leading number of a cell, like std::stod / std::stoul: leading blanks
+// and a '+' are skipped and trailing text is ignored. False if there is
+// no number at all (e.g. an empty cell).
+template <class N>
+inline bool parse(std::string_view cell, N& out) {
+    static_assert(std::is_arithmetic<N>::value, "no csv::parse for this type");
+    std::size_t i = 0;
+    while (i < cell.size() && (cell[i] == ' ' || cell[i] == '\t')) ++i;
+    if (i < cell.size() && cell[i] == '+') ++i;     // from_chars rejects '+'
+    auto res = std::from_chars(cell.data() + i, cell.data() + cell.size(), out);
+    return res.ec == std::errc();
+}
+
+inline bool parse(std::string_view cell, std::string& out) {
+    out.assign(cell.data(), cell.size());
+    return true;
+}
+
+// Zero-copy: the view points into the reader's buffer
+inline bool parse(std::string_view cell, std::string_view& out) {
+    out = cell;
+    return true;
+}
+
+// True if the whole cell (ignoring blanks) is a number
+inline bool isNumber(std::string_view cell) {
+    while (!cell.empty() && (cell.back() == ' ' || cell.back() == '\t'))
+        cell.remove_suffix(1);
+    std::size_t i = 0;
+    while (i < cell.size() && (cell[i] == ' ' || cell[i] == '\t')) ++i;
+    if (i < cell.size() && cell[i] == '+') ++i;
+    double v;
+    auto res = std::from_chars(cell.data() + i, cell.data() + cell.size(), v);
+    return res.ec == std::errc() && res.ptr == cell.data() + cell.size();
+}
+
+// Rough number of records in a file, from the average line length of its
+// first `sample` bytes; meant for reserving column storage up front
+inline std::size_t estimateRows(const std::string& path, std::size_t sample = 1 << 16) {
+    std::FILE* f = std::fopen(path.c_str(), "rb");
+    if (!f) return 0;
+    std::vector<char> head(sample);
+    std::size_t got = std::fread(head.data(), 1, head.size(), f);
+    std::fseek(f, 0, SEEK_END);
+    long size = std::ftell(f);
+    std::fclose(f);
+    std::size_t lines = 0;
+    for (std::size_t i = 0; i < got; ++i) lines += head[i] == '\n';
+    if (got < sample || size <= 0) return lines + 1; // Sampled the whole file
+    return (std::size_t)((double)size / got * lines * 1.05) + 16; // Slack: line lengths vary
+}
+
+// Cut the bytes of a file from `from` to its end into `parts` ranges that
+// each begin at the start of a line. Returns the boundaries (parts + 1
+// offsets, ascending; empty ranges are possible for tiny files).
+inline std::vector<std::uint64_t> splitLines(const std::string& path, std::uint64_t from,
+                                             std::size_t parts) {
+    std::FILE* f = std::fopen(path.c_str(), "rb");
+    if (!f) throw std::runtime_error("Cannot open " + path);
+    std::fseek(f, 0, SEEK_END);
+    std::uint64_t size = (std::uint64_t)std::ftell(f);
+    if (from > size) from = size;
+    if (parts == 0) parts = 1;
+    std::vector<std::uint64_t> cuts{from};
+    char block[4096];
+    for (std::size_t k = 1; k < parts; ++k) {
+        std::uint64_t pos = from + (size - from) * k / parts;
+        if (pos <= cuts.back()) pos = cuts.back();
+        else {                                  // Move to just past the next '\n'
+            std::uint64_t at = pos - 1;         // A cut right after '\n' stays
+            std::fseek(f, (long)at, SEEK_SET);
+            pos = size;
+            while (std::size_t got = std::fread(block, 1, sizeof block, f)) {
+                if (const void* nl = std::memchr(block, '\n', got)) {
+                    pos = at + (std::uint64_t)((const char*)nl - block) + 1;
+                    break;
+                }
+                at += got;
+            }
+        }
+        cuts.push_back(pos);
+    }
+    cuts.push_back(size);
+    std::fclose(f);
+    return cuts;
+}
+
+// ----------------------------------------------------------------- header
+
+// Column names, one row per header line. Files such as yfinance exports
+// have a field row (Date,Close,High,...) and a ticker row (,GOOGL,...).
+struct Header {
+    std::vector<std::vector<std::string>> rows;
+
+    std::size_t width() const { return rows.empty() ? 0 : rows[0].size(); }
+
+    // First column named `name` in any header row, or -1
+    int find(std::string_view name) const {
+        for (std::size_t c = 0; c < width(); ++c)
+            for (auto& row : rows)
+                if (c < row.size() && row[c] == name) return (int)c;
+        return -1;
+    }
+
+    // First column named `name` in one header row and `sub` in another
+    // (e.g. field "Close" for ticker "GOOGL"), or -1
+    int find(std::string_view name, std::string_view sub) const {
+        for (std::size_t c = 0; c < width(); ++c) {
+            bool hasName = false, hasSub = false;
+            for (auto& row : rows) {
+                if (c >= row.size()) continue;
+                hasName = hasName || row[c] == name;
+                hasSub = hasSub || row[c] == sub;
+            }
+            if (hasName && hasSub) return (int)c;
+        }
+        return -1;
+    }
+};
+
+// ----------------------------------------------------------------- reader
+
+class Reader {
+public:
+    explicit Reader(const std::string& path, char delimiter = ',',
+                    std::size_t blockSize = 1 << 20)
+        : in(std::fopen(path.c_str(), "rb")), delim(delimiter),
+          buf(blockSize < 64 ? 64 : blockSize) {
+        if (!in) throw std::runtime_error("Cannot open " + path);
+    }
+    // Only the records in bytes [from, to) of the file; `from` should be
+    // the start of a line (see splitLines)
+    Reader(const std::string& path, std::uint64_t from, std::uint64_t to,
+           char delimiter = ',', std::size_t blockSize = 1 << 20)
+        : Reader(path, delimiter, blockSize) {
+        if (std::fseek(in, (long)from, SEEK_SET) != 0)
+            throw std::runtime_error("Cannot seek in " + path);
+        offset = from;
+        budget = to > from ? to - from : 0;
+    }
+    ~Reader() { if (in) std::fclose(in); }
+    Reader(const Reader&) = delete;
+    Reader& operator=(const Reader&) = delete;
+
+    // Read the header. With lines == 0 the first line is the header and
+    // each following line is one more header row (ticker rows, "Date,,,,"
+    // rows) unless it holds a numeric cell or starts with a digit (a date,
+    // e.g. a row of a wide file where no ticker is listed yet); otherwise
+    // exactly `lines`.
+    Header readHeader(std::size_t lines = 1) {
+        Header h;
+        while (next()) {
+            bool more = lines > 0 ? h.rows.size() < lines : h.rows.empty() || !numeric();
+            if (!more) { pending = true; break; } // First data row: keep it
+            h.rows.emplace_back(cells.begin(), cells.end());
+            if (lines > 0 && h.rows.size() == lines) break;
+        }
+        return h;
+    }
+
+    // Advance to the next record; false at the end of the file
+    bool next() {
+        if (pending) { pending = false; return true; }
+        while (true) {
+            std::size_t nl = findRecordEnd();
+            if (nl == npos) return false;
+            std::size_t stop = nl < end ? nl : end;   // Last line may lack '\n'
+            lineNo = nextLine;
+            nextLine += 1 + extraLines;
+            split(begin, stop);
+            recordStart = offset + begin;
+            begin = nl < end ? nl + 1 : end;
+            if (cells.size() == 1 && cells[0].empty() && !quotedCell) continue;
+            return true;
+        }
+    }
+
+    std::size_t size() const { return cells.size(); }
+    std::string_view operator[](std::size_t i) const { return cells[i]; }
+    const std::vector<std::string_view>& row() const { return cells; }
+    std::size_t line() const { return lineNo; }       // 1-based line of the record
+
+    // File offset where the next record starts (the held-back first data
+    // row after readHeader(0) included); the `from` of a follow-on range
+    std::uint64_t position() const { return pending ? recordStart : offset + begin; }
+
+private:
+    static constexpr std::size_t npos = (std::size_t)-1;
+
+    // True if any cell of the current record is a number, or the first
+    // one starts with a digit
+    bool numeric() const {
+        if (!cells.empty() && !cells[0].empty() && cells[0][0] >= '0' && cells[0][0] <= '9')
+            return true;
+        for (auto c : cells)
+            if (isNumber(c)) return true;
+        return false;
+    }
+
+    // Index of the '\n' ending the record at `begin` (or `end` for a final
+    // record without one), reading more input as needed; npos at EOF
+    std::size_t findRecordEnd() {
+        std::size_t from = begin;             // Where the '\n' search resumes
+        while (true) {
+            std::size_t nl = scan(from);
+            if (nl != npos) return nl;
+            if (eof) return begin < end ? end : npos;
+            std::size_t seen = end - begin;   // Already searched, no '\n'
+            refill();
+            from = begin + seen;
+        }
+    }
+
+    // Find the record end starting at `from`. Records without quotes end
+    // at the next '\n' (memchr); otherwise newlines inside quotes are skipped.
+    std::size_t scan(std::size_t from) {
+        const char* base = buf.data();
+        extraLines = 0;
+        const void* p = std::memchr(base + from, '\n', end - from);
+        std::size_t nl = p ? (const char*)p - base : npos;
+        std::size_t limit = nl == npos ? end : nl;
+        if (!std::memchr(base + begin, '"', limit - begin)) return nl;
+        bool inside = false;                   // Slow path: track quote state
+        for (std::size_t i = begin; i < end; ++i) {
+            if (base[i] == '"') inside = !inside;
+            else if (base[i] == '\n') {
+                if (!inside) return i;
+                ++extraLines;
+            }
+        }
+        return npos;
+    }
+
+    // Keep the unfinished record and read the next block behind it
+    void refill() {
+        std::size_t keep = end - begin;
+        if (keep) std::memmove(buf.data(), buf.data() + begin, keep);
+        offset += begin;
+        begin = 0;
+        end = keep;
+        if (end == buf.size()) buf.resize(buf.size() * 2); // Record longer than the buffer
+        std::size_t want = buf.size() - end;
+        if (want > budget) want = (std::size_t)budget;
+        std::size_t got = std::fread(buf.data() + end, 1, want, in);
+        budget -= got;
+        end += got;
+        if (got == 0) eof = true;
+    }
+
+    // Split [b, e) into cells, unquoting in place
+    void split(std::size_t b, std::size_t e) {
+        char* base = buf.data();
+        if (e > b && base[e - 1] == '\r') --e;
+        cells.clear();
+        quotedCell = false;
+        std::size_t i = b;
+        while (true) {
+            if (i < e && base[i] == '"') {
+                quotedCell = true;
+                std::size_t out = i, r = i + 1;   // Compact "" -> " while copying
+                while (r < e) {
+                    if (base[r] == '"') {
+                        if (r + 1 < e && base[r + 1] == '"') { base[out++] = '"'; r += 2; continue; }
+                        ++r;                      // Closing quote
+                        break;
+                    }
+                    base[out++] = base[r++];
+                }
+                cells.emplace_back(base + i, out - i);
+                while (r < e && base[r] != delim) ++r; // Text after the quote is dropped
+                if (r >= e) return;
+                i = r + 1;
+                continue;
+            }
+            const void* d = std::memchr(base + i, delim, e - i);
+            if (!d) {
+                cells.emplace_back(base + i, e - i);
+                return;
+            }
+            std::size_t j = (const char*)d - base;
+            cells.emplace_back(base + i, j - i);
+            i = j + 1;
+        }
+    }
+
+    std::FILE* in;
+    char delim;
+    std::vector<char> buf;
+    std::size_t begin = 0, end = 0;            // Unconsumed bytes
+    std::uint64_t offset = 0;                  // File offset of buf[0]
+    std::uint64_t budget = (std::uint64_t)-1;  // Bytes left to read in the range
+    std::uint64_t recordStart = 0;             // File offset of the current record
+    bool eof = false;
+    bool quotedCell = false;                   // Current record has a quoted cell
+    bool pending = false;                      // next() returns the current record again
+    std::size_t extraLines = 0;                // Line breaks inside quotes
+    std::size_t lineNo = 0, nextLine = 1;
+    std::vector<std::string_view> cells;
+};
+
+// ---------------------------------------------------------- typed mapping
+
+// One struct field filled from one column, found by name or position
+template <class T, class M>
+struct Column {
+    std::string name;                          // Header name (empty = use index)
+    M T::*member;
+    int index = -1;                            // Resolved column
+};
+
+template <class T, class M>
+Column<T, M> column(std::string name, M T::*member) {
+    return {std::move(name), member, -1};
+}
+
+template <class T, class M>
+Column<T, M> column(int index, M T::*member) {
+    return {std::string(), member, index};
+}
+
+// Maps columns to fields of T. The column list is a template parameter
+// pack, so reading a row is a fixed sequence of typed parse calls.
+template <class T, class... Ms>
+class RowMapping {
+public:
+    explicit RowMapping(Column<T, Ms>... c) : cols(std::move(c)...) {}
+
+    // Resolve column names against the header; throws naming a missing column
+    void bind(const Header& header) {
+        std::apply([&](auto&... c) { (resolve(c, header), ...); }, cols);
+    }
+
+    // Fill `out` from the reader's current record; false if a column is
+    // missing from the row or a cell does not parse
+    bool read(const Reader& in, T& out) const {
+        return std::apply([&](const auto&... c) { return (field(c, in, out) && ...); }, cols);
+    }
+
+private:
+    template <class M>
+    static void resolve(Column<T, M>& c, const Header& header) {
+        if (c.name.empty()) return;
+        c.index = header.find(c.name);
+        if (c.index < 0) throw std::runtime_error("Missing column " + c.name);
+    }
+
+    template <class M>
+    static bool field(const Column<T, M>& c, const Reader& in, T& out) {
+        return c.index >= 0 && (std::size_t)c.index < in.size()
+            && parse(in[c.index], out.*(c.member));
+    }
+
+    std::tuple<Column<T, Ms>...> cols;
+};
+
+template <class T, class... Ms>
+RowMapping<T, Ms...> mapping(Column<T, Ms>... c) {
+    return RowMapping<T, Ms...>(std::move(c)...);
+}
+
+} // namespace csv
+#endif // CSVREADER_H
@@ -1,8 +1,10 @@
 #include "ASCIIPlotter.h"
+#include <cmath>                                // For std::isnan
 #include <iostream>                             // For std::cout
 #include <iomanip>                              // For std::setw
 
-void ASCIIPlotter::plot(const std::vector<Candlestick>& candles) {
+void ASCIIPlotter::plot(const std::vector<Candlestick>& candles,
+                        const IndicatorSeries* overlay) {
     if (candles.empty()) return;             // Nothing to plot
 
     double minT = candles.front().low;       // Initialize min temp
@@ -11,22 +13,44 @@ void ASCIIPlotter::plot(const std::vector<Candlestick>& candles) {
         if (c.low  < minT)  minT = c.low;
         if (c.high > maxT) maxT = c.high;
     }
+    if (overlay) {                           // Bands may poke outside the wicks
+        for (std::size_t i = 0; i < candles.size(); ++i) {
+            if (overlay->lower[i] < minT) minT = overlay->lower[i];
+            if (overlay->upper[i] > maxT) maxT = overlay->upper[i];
+        }
+    }
     int width = 50;                            // Chart width
+    // Map a value to a column
+    auto pos = [&](double v) { return (int)((v - minT) / (maxT - minT) * (width - 1)); };
 
-    for (auto& c : candles) {
+    for (std::size_t k = 0; k < candles.size(); ++k) {
+        const Candlestick& c = candles[k];
         // Map values to positions
-        int lp = (int)((c.low   - minT) / (maxT - minT) * (width - 1));
-        int hp = (int)((c.high  - minT) / (maxT - minT) * (width - 1));
-        int op = (int)((c.open  - minT) / (maxT - minT) * (width - 1));
-        int cp = (int)((c.close - minT) / (maxT - minT) * (width - 1));
+        int lp = pos(c.low);
+        int hp = pos(c.high);
+        int op = pos(c.open);
+        int cp = pos(c.close);
         std::string line(width, ' ');          // Line buffer
 
         line[lp] = '|';                        // Draw low wick
         line[hp] = '|';                        // Draw high wick
         for (int i = std::min(op, cp); i <= std::max(op, cp); ++i)
             line[i] = '#';                    // Draw body
+        if (c.hasQuantiles)                    // Mark the median
+            line[pos(c.median)] = '+';
+        if (overlay && !std::isnan(overlay->sma[k])) { // Draw indicator overlay
+            line[pos(overlay->lower[k])] = ':';
+            line[pos(overlay->upper[k])] = ':';
+            line[pos(overlay->sma[k])]   = '~';
+        }
 
         // Print period and ASCII chart
-        std::cout << std::setw(8) << c.period << " | " << line << '\n';
+        std::cout << std::setw(8) << c.period << " | " << line;
+        if (c.anomalies > 0)                   // Mark periods with anomalies
+            std::cout << " !" << c.anomalies;
+        if (c.hasQuantiles)                    // Append distribution summary
+            std::cout << " p5=" << c.p5 << " med=" << c.median
+                      << " p95=" << c.p95;
+        std::cout << '\n';
     }
 }
@@ -2,10 +2,13 @@
 #define ASCII_PLOTTER_H
 #include <vector>
 #include "Candlestick.h"
+#include "IndicatorEngine.h"                        // For IndicatorSeries
 
 class ASCIIPlotter {
 public:
-    // Plot ASCII candlestick chart
-    static void plot(const std::vector<Candlestick>& candles);
+    // Plot ASCII candlestick chart, optionally overlaying one indicator
+    // series (SMA drawn as '~', Bollinger bands as ':')
+    static void plot(const std::vector<Candlestick>& candles,
+                     const IndicatorSeries* overlay = nullptr);
 };
 #endif // ASCII_PLOTTER_H
@@ -0,0 +1,96 @@
+#include "AnomalyDetector.h"
+#include <algorithm>                             // For nth_element
+#include <cmath>                                 // For sqrt, fabs
+#include <stdexcept>
+
+AnomalyDetector::AnomalyDetector(const Config& config)
+    : cfg(config) {
+    if (cfg.window < 3) throw std::invalid_argument("Anomaly window must be >= 3");
+    ring.reserve(cfg.window);
+    scratch.reserve(cfg.window);
+}
+
+unsigned AnomalyDetector::update(double temp) {
+    unsigned flags = 0;
+    std::size_t n = ring.size();
+
+    if (seen > 0 && std::fabs(temp - prev) > cfg.jumpLimit)
+        flags |= JUMP;                         // Sudden step
+
+    if (n == cfg.window) {                     // Only score on a full window
+        double var = std::max(0.0, m2 / n);
+        if (var <= 1e-12 * mean * mean) var = 0; // Rounding residue of a flat window
+        double sd  = std::sqrt(var);
+        double z    = sd > 0 ? std::fabs(temp - mean) / sd : 0;
+        if (z > cfg.zThreshold) flags |= ZSCORE;
+
+        bool extreme = temp < minQ.front().second || temp > maxQ.front().second;
+        if (extreme || z > cfg.zThreshold / 2) { // MAD only for candidates
+            scratch.assign(ring.begin(), ring.end());
+            auto mid = scratch.begin() + n / 2;
+            std::nth_element(scratch.begin(), mid, scratch.end());
+            double median = *mid;
+            for (auto& v : scratch) v = std::fabs(v - median);
+            std::nth_element(scratch.begin(), mid, scratch.end());
+            double mad = *mid;
+            // 0.6745 scales MAD to a standard deviation for normal data
+            if (mad > 0 && 0.6745 * std::fabs(temp - median) / mad > cfg.madThreshold)
+                flags |= MAD;
+        }
+    }
+
+    // Slide the window: replace the oldest reading by this one (windowed
+    // Welford update of mean and squared deviations), or grow it
+    if (n == cfg.window) {
+        double old = ring[head];
+        double newMean = mean + (temp - old) / n;
+        m2 += (temp - old) * (temp - newMean + old - mean);
+        mean = newMean;
+        ring[head] = temp;
+        head = (head + 1) % cfg.window;
+        if (head == 0) rebase();              // Once per window, drop drift
+    } else {
+        ring.push_back(temp);
+        double delta = temp - mean;
+        mean += delta / ring.size();
+        m2 += delta * (temp - mean);
+    }
+
+    long oldest = seen - (long)cfg.window;     // Index that just left the window
+    while (!minQ.empty() && minQ.back().second >= temp) minQ.pop_back();
+    while (!maxQ.empty() && maxQ.back().second <= temp) maxQ.pop_back();
+    minQ.push_back({seen, temp});
+    maxQ.push_back({seen, temp});
+    if (minQ.front().first <= oldest) minQ.pop_front();
+    if (maxQ.front().first <= oldest) maxQ.pop_front();
+
+    if (ring.size() == cfg.window
+        && maxQ.front().second - minQ.front().second < 1e-9)
+        flags |= FLATLINE;                     // Whole window identical
+
+    prev = temp;
+    ++seen;
+    return flags;
+}
+
+void AnomalyDetector::rebase() {
+    double total = 0;
+    for (double v : ring) total += v;
+    mean = total / ring.size();
+    m2 = 0;
+    for (double v : ring) m2 += (v - mean) * (v - mean);
+}
+
+std::string AnomalyDetector::describe(unsigned flags) {
+    std::string out;
+    auto add = [&](unsigned bit, const char* name) {
+        if (!(flags & bit)) return;
+        if (!out.empty()) out += ',';
+        out += name;
+    };
+    add(ZSCORE, "zscore");
+    add(MAD, "mad");
+    add(JUMP, "jump");
+    add(FLATLINE, "flatline");
+    return out;
+}
@@ -0,0 +1,61 @@
+#ifndef ANOMALYDETECTOR_H
+#define ANOMALYDETECTOR_H
+#include <cstddef>                                  // For std::size_t
+#include <deque>                                    // Monotonic deques
+#include <string>
+#include <vector>
+
+// Flagged reading with the detectors that fired
+struct Anomaly {
+    std::string timestamp;                     // When it happened
+    double temperature;                        // Reading that was flagged
+    unsigned flags;                            // AnomalyDetector::Flag bits
+};
+
+// Streaming detector for sensor faults and extreme events. Each reading is
+// scored against the previous `window` readings in O(1) amortised time:
+// a windowed Welford update of mean and squared deviations (recomputed from
+// the window once per `window` readings, so rounding cannot build up) gives
+// the rolling z-score and monotonic deques give the rolling min/max. The
+// MAD (median absolute deviation) test needs a median, so it is only
+// evaluated for candidates (new window extreme or |z| above half the z
+// threshold) with an O(window) selection; ordinary readings never pay it.
+class AnomalyDetector {
+public:
+    enum Flag : unsigned {
+        ZSCORE   = 1,                          // |x - mean| / sd too large
+        MAD      = 2,                          // Robust (median/MAD) outlier
+        JUMP     = 4,                          // Step from previous reading
+        FLATLINE = 8                           // Stuck sensor: no variation
+    };
+
+    struct Config {
+        std::size_t window  = 48;              // Readings in the rolling window
+        double zThreshold   = 4.0;             // Rolling z-score limit
+        double madThreshold = 5.0;             // Robust z-score limit
+        double jumpLimit    = 8.0;             // Max step between readings
+    };
+
+    explicit AnomalyDetector(const Config& config);
+
+    // Score one reading (in time order), then add it to the window;
+    // returns the Flag bits that fired (0 for a normal reading)
+    unsigned update(double temp);
+
+    // Comma-separated flag names, e.g. "zscore,jump"
+    static std::string describe(unsigned flags);
+
+private:
+    Config cfg;
+    std::vector<double> ring;                  // Last `window` readings
+    std::size_t head = 0;                      // Next slot to overwrite
+    long seen = 0;                             // Readings so far
+    double mean = 0, m2 = 0;                   // Window mean, sum of squared deviations
+    std::deque<std::pair<long, double>> minQ;  // Increasing values
+    std::deque<std::pair<long, double>> maxQ;  // Decreasing values
+    double prev = 0;                           // Previous reading
+    std::vector<double> scratch;               // Work buffer for the MAD test
+
+    void rebase();                             // Recompute mean and m2 from ring
+};
+#endif // ANOMALYDETECTOR_H
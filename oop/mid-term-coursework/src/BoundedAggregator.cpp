@@ -0,0 +1,156 @@
+#include "BoundedAggregator.h"
+#include <algorithm>                             // For std::min, std::max
+#include <functional>                            // For std::function
+#include <queue>                                 // For the k-way merge heap
+#include <stdexcept>                             // For exceptions
+
+namespace {
+// Conservative per-entry footprints (object, heap strings, allocator and
+// map node overhead) used to turn the byte budget into entry counts
+const std::size_t kPartialBytes = 320;        // One map entry
+const std::size_t kSketchBytes  = 8192;       // Worst-case quantile sketch
+const std::size_t kRecordBytes  = 64;         // One buffered record + arena text
+const std::size_t kBaseBytes    = 4u << 20;   // Runtime, stream buffers, etc.
+const std::size_t kMaxFanIn     = 16;         // Runs merged at once
+const std::size_t kMaxRuns      = 64;         // Open run files, whatever the budget
+
+// K-way merge of period-sorted runs: same-period partials are folded
+// together and each merged aggregate is passed to `out` in period order.
+// Ties go to the older run so earlier input keeps precedence.
+void mergeRuns(const std::vector<std::FILE*>& runs,
+               const std::function<void(PeriodAggregate&)>& out) {
+    // Heap of (current aggregate, run index), smallest period on top
+    using Head = std::pair<PeriodAggregate, std::size_t>;
+    auto later = [](const Head& a, const Head& b) {
+        return a.first.period != b.first.period ? a.first.period > b.first.period
+                                                : a.second > b.second;
+    };
+    std::priority_queue<Head, std::vector<Head>, decltype(later)> heap(later);
+    for (std::size_t i = 0; i < runs.size(); ++i) {
+        std::rewind(runs[i]);
+        PeriodAggregate agg;
+        if (agg.read(runs[i])) heap.push({std::move(agg), i});
+    }
+
+    // Pop the head and pull the next aggregate from the same run
+    auto popHead = [&]() {
+        Head h = heap.top();
+        heap.pop();
+        PeriodAggregate next;
+        if (next.read(runs[h.second])) heap.push({std::move(next), h.second});
+        return h.first;
+    };
+    while (!heap.empty()) {
+        PeriodAggregate cur = popHead();       // Start a new period
+        while (!heap.empty() && heap.top().first.period == cur.period)
+            cur.merge(popHead());              // Fold same-period partials
+        out(cur);
+    }
+}
+
+std::FILE* newRun() {
+    std::FILE* f = std::tmpfile();            // Anonymous, auto-deleted file
+    if (!f) throw std::runtime_error("Cannot create spill file");
+    return f;
+}
+}
+
+BoundedAggregator::BoundedAggregator(Period period, std::size_t memLimit,
+                                     bool quantiles)
+    : keyLen(CandlestickBuilder::keyLength(period)),
+      quantiles(quantiles),
+      partialBytes(kPartialBytes + (quantiles ? kSketchBytes : 0)) {
+    if (memLimit <= kBaseBytes)
+        throw std::runtime_error("Memory limit too small (need more than 4M)");
+    std::size_t usable = memLimit - kBaseBytes;
+    windowBudget = usable / 4;                // Quarter for the read window
+    budget = usable / 2;                      // Half for partials, rest is slack
+    // The merge heap holds one partial per run; keep it within the budget
+    fanIn = std::max<std::size_t>(2, std::min(kMaxFanIn, budget / partialBytes));
+}
+
+BoundedAggregator::~BoundedAggregator() {
+    for (auto* f : spills) std::fclose(f);    // tmpfile() removes on close
+}
+
+std::size_t BoundedAggregator::windowRows() const {
+    return windowBudget / kRecordBytes;
+}
+
+void BoundedAggregator::add(const WeatherRecord& r) {
+    if (r.timestamp.size() < keyLen) return;  // Unlabelled record
+    std::string_view key = r.timestamp.substr(0, keyLen);
+    if (key > lastKey) {                      // Earlier periods have closed
+        if (!lastKey.empty()) spill(partials.lower_bound(key));
+        lastKey = key;
+    }
+    auto it = partials.find(key);             // Heterogeneous lookup, no copy
+    if (it == partials.end())
+        it = partials.emplace(std::string(key), PeriodAggregate()).first;
+    auto& agg = it->second;
+    agg.quantiles = quantiles;
+    agg.add(r.timestamp, r.temperature);
+    if (partials.size() * partialBytes > budget) spill(partials.end());
+}
+
+void BoundedAggregator::spill(Partials::iterator end) {
+    if (partials.begin() == end) return;
+    // Append to the newest run while periods keep increasing (time-ordered
+    // input); otherwise start a new run
+    bool fresh = spills.empty() || partials.begin()->first <= tailKey;
+    if (fresh) {
+        spills.push_back(newRun());
+        levels.push_back(0);
+    }
+    for (auto it = partials.begin(); it != end; ++it) {
+        it->second.period = it->first;        // Map order keeps runs sorted
+        it->second.write(spills.back());
+        tailKey = it->first;
+    }
+    partials.erase(partials.begin(), end);
+    if (fresh) compact();
+}
+
+void BoundedAggregator::compact() {
+    // Tiered merging: fanIn runs of one level become one run of the next,
+    // so each partial is rewritten about log(runs) / log(fanIn) times.
+    // Only the newest runs are merged, which keeps older input first.
+    for (;;) {
+        std::size_t n = spills.size(), same = 1;
+        while (same < n && levels[n - 1 - same] == levels[n - 1]) ++same;
+        if (same < fanIn && n <= kMaxRuns) break;
+        std::size_t first = n - fanIn;
+        std::vector<std::FILE*> tail(spills.begin() + first, spills.end());
+        unsigned level = *std::max_element(levels.begin() + first, levels.end()) + 1;
+        std::FILE* merged = newRun();
+        try {
+            mergeRuns(tail, [&](PeriodAggregate& agg) {
+                agg.write(merged);
+                tailKey = agg.period;
+            });
+        } catch (...) {
+            std::fclose(merged);
+            throw;
+        }
+        for (auto* f : tail) std::fclose(f);
+        spills.resize(first);
+        levels.resize(first);
+        spills.push_back(merged);
+        levels.push_back(level);
+    }
+}
+
+std::vector<Candlestick> BoundedAggregator::finish() {
+    std::vector<Candlestick> candles;
+    if (spills.empty()) {                     // Everything fit in memory
+        for (auto& kv : partials) {
+            kv.second.period = kv.first;
+            candles.push_back(kv.second.toCandle());
+        }
+        partials.clear();
+        return candles;
+    }
+    spill(partials.end());                    // Uniform handling of the tail
+    mergeRuns(spills, [&](PeriodAggregate& agg) { candles.push_back(agg.toCandle()); });
+    return candles;
+}
@@ -0,0 +1,62 @@
+#ifndef BOUNDEDAGGREGATOR_H
+#define BOUNDEDAGGREGATOR_H
+#include <cstddef>                                  // For std::size_t
+#include <cstdio>                                   // For std::FILE
+#include <map>                                      // For partial aggregates
+#include <string>
+#include <vector>
+#include "CandlestickBuilder.h"                     // For Period
+#include "PeriodAggregate.h"
+
+// Builds candlesticks within a fixed memory budget. Partial per-period
+// aggregates are kept in memory until their period closes (a reading of a
+// later period arrives) or they exceed their share of the budget; then
+// they are written, period-sorted, to a run file. Closed periods of input
+// in time order are appended to the same run, so sorted input makes a
+// single run. Runs are merged in several passes, at most mergeFanIn() at a time
+// (bounded by the budget, so the merge heap fits) and with a fixed cap on
+// open files; finish() merges what is left with the in-memory tail.
+class BoundedAggregator {
+public:
+    BoundedAggregator(Period period,           // Grouping period
+                      std::size_t memLimit,    // Budget in bytes
+                      bool quantiles = false); // Add p5/median/p95 fields
+    ~BoundedAggregator();                      // Closes (and removes) spills
+
+    BoundedAggregator(const BoundedAggregator&) = delete;
+    BoundedAggregator& operator=(const BoundedAggregator&) = delete;
+
+    // Number of records the loader should read per window
+    std::size_t windowRows() const;
+
+    // Fold one record into the partial aggregates
+    void add(const WeatherRecord& r);
+
+    // Merge spills and in-memory partials into period-sorted candles
+    std::vector<Candlestick> finish();
+
+    // Number of run files currently open
+    std::size_t spillCount() const { return spills.size(); }
+
+    // Most runs merged at once
+    std::size_t mergeFanIn() const { return fanIn; }
+
+private:
+    using Partials = std::map<std::string, PeriodAggregate, std::less<>>;
+
+    void spill(Partials::iterator end);        // Write partials before end to a run
+    void compact();                            // Merge runs down to the limits
+
+    std::size_t keyLen;                        // Period label length
+    bool quantiles;                            // Sketch each period?
+    std::size_t partialBytes;                  // Estimated bytes per partial
+    std::size_t budget;                        // Bytes allowed for partials
+    std::size_t windowBudget;                  // Bytes allowed for a window
+    std::size_t fanIn;                         // Runs merged at once
+    Partials partials;                         // In-memory partials
+    std::string lastKey;                       // Period of the latest record
+    std::vector<std::FILE*> spills;            // Period-sorted runs, oldest first
+    std::vector<unsigned> levels;              // Merge passes behind each run
+    std::string tailKey;                       // Last period in spills.back()
+};
+#endif // BOUNDEDAGGREGATOR_H
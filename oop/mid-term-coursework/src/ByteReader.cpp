@@ -0,0 +1,43 @@
+#include "ByteReader.h"
+#include <cstring>                               // For memcmp, memcpy
+#include <fstream>
+#include <iterator>                              // For istreambuf_iterator
+
+ByteReader::ByteReader(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) { good = false; return; }
+    buf.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+std::uint64_t ByteReader::le(int n) {
+    if (!good || remaining() < (std::size_t)n) { good = false; return 0; }
+    std::uint64_t v = 0;
+    for (int i = n - 1; i >= 0; --i) v = v << 8 | (unsigned char)buf[pos + i];
+    pos += n;
+    return v;
+}
+
+double ByteReader::f64le() {
+    std::uint64_t bits = le(8);
+    double v;
+    std::memcpy(&v, &bits, sizeof v);
+    return v;
+}
+
+bool ByteReader::expect(const char* bytes, std::size_t n) {
+    if (!good || remaining() < n || std::memcmp(&buf[pos], bytes, n) != 0)
+        return good = false;
+    pos += n;
+    return true;
+}
+
+std::string ByteReader::bytes(std::size_t n) {
+    if (!good || remaining() < n) { good = false; return {}; }
+    pos += n;
+    return buf.substr(pos - n, n);
+}
+
+std::string ByteReader::str() {
+    std::size_t n = u32le();
+    return bytes(n);
+}
@@ -0,0 +1,31 @@
+#ifndef BYTEREADER_H
+#define BYTEREADER_H
+#include <cstdint>                                  // Fixed-width integers
+#include <string>
+
+// Reads the little-endian fields BufferedWriter writes, from a whole file
+// loaded into memory. A read past the end (or a file that could not be
+// opened) returns zeros and clears ok(), so callers check once at the end.
+class ByteReader {
+public:
+    explicit ByteReader(const std::string& path);
+
+    bool ok() const { return good; }
+    std::size_t remaining() const { return buf.size() - pos; }
+
+    // Consume `n` bytes if they equal `bytes` (magic numbers)
+    bool expect(const char* bytes, std::size_t n);
+    std::string bytes(std::size_t n);          // Raw bytes
+    std::string str();                         // u32 length, then bytes
+    std::uint32_t u32le() { return (std::uint32_t)le(4); }
+    std::uint64_t u64le() { return le(8); }
+    double f64le();
+
+private:
+    std::uint64_t le(int n);
+
+    std::string buf;
+    std::size_t pos = 0;
+    bool good = true;
+};
+#endif // BYTEREADER_H
@@ -0,0 +1,113 @@
+#include "CandleExporter.h"
+#include <algorithm>                             // For std::min
+#include <cmath>                                 // For NAN
+#include <stdexcept>
+#include "BufferedWriter.h"                      // Buffered to_chars output
+#include "ByteReader.h"
+
+namespace {
+void writeCSV(BufferedWriter& w, const std::vector<Candlestick>& candles) {
+    w.put("period,open,high,low,close,count,p5,median,p95,anomalies\n");
+    for (auto& c : candles) {
+        w.put(c.period);
+        for (double v : {c.open, c.high, c.low, c.close}) { w.put(','); w.number(v); }
+        w.put(',');
+        w.number((long long)c.count);
+        for (double v : {c.p5, c.median, c.p95}) {
+            w.put(',');
+            if (c.hasQuantiles) w.number(v);   // Empty cell when absent
+        }
+        w.put(',');
+        w.number((long long)c.anomalies);
+        w.put('\n');
+    }
+}
+
+void writeNDJSON(BufferedWriter& w, const std::vector<Candlestick>& candles) {
+    // Period labels are digits and dashes, so they need no escaping
+    auto number = [&](double v) {
+        if (std::isfinite(v)) w.number(v);
+        else                  w.put("null");  // JSON has no NaN
+    };
+    for (auto& c : candles) {
+        w.put("{\"period\":\"");
+        w.put(c.period);
+        w.put("\",\"open\":");   number(c.open);
+        w.put(",\"high\":");      number(c.high);
+        w.put(",\"low\":");       number(c.low);
+        w.put(",\"close\":");     number(c.close);
+        w.put(",\"count\":");     w.number((long long)c.count);
+        if (c.hasQuantiles) {
+            w.put(",\"p5\":");     number(c.p5);
+            w.put(",\"median\":"); number(c.median);
+            w.put(",\"p95\":");    number(c.p95);
+        }
+        w.put(",\"anomalies\":"); w.number((long long)c.anomalies);
+        w.put("}\n");
+    }
+}
+}
+
+void CandleExporter::write(const std::string& path,
+                           const std::vector<Candlestick>& candles,
+                           ExportFormat format) {
+    BufferedWriter w(path);
+    switch (format) {
+    case ExportFormat::CSV:    writeCSV(w, candles);    break;
+    case ExportFormat::NDJSON: writeNDJSON(w, candles); break;
+    case ExportFormat::BINARY: writeBinary(w, candles); break;
+    }
+    w.flush();                                 // Surface write errors here
+}
+
+void CandleExporter::writeBinary(BufferedWriter& w, const std::vector<Candlestick>& candles) {
+    bool quantiles = !candles.empty() && candles.front().hasQuantiles;
+    w.put("WTCANDL1", 8);
+    w.u32le(1);                                // Version
+    w.u32le(quantiles ? 1 : 0);                // Flags
+    w.u64le(candles.size());
+    for (auto& c : candles) {
+        char label[16] = {0};
+        c.period.copy(label, sizeof label);    // Truncated/NUL-padded
+        w.put(label, sizeof label);
+        for (double v : {c.open, c.high, c.low, c.close}) w.f64le(v);
+        for (double v : {c.p5, c.median, c.p95}) w.f64le(c.hasQuantiles ? v : NAN);
+        w.u64le((std::uint64_t)c.count);
+        w.u32le((std::uint32_t)c.anomalies);
+        w.u32le(0);                            // Reserved
+    }
+}
+
+bool CandleExporter::readBinary(ByteReader& in, std::vector<Candlestick>& candles) {
+    if (!in.expect("WTCANDL1", 8) || in.u32le() != 1) return false;
+    bool quantiles = in.u32le() & 1;
+    std::uint64_t n = in.u64le();
+    if (!in.ok() || in.remaining() / 88 < n) return false;
+    candles.clear();
+    candles.reserve(n);
+    for (std::uint64_t i = 0; i < n; ++i) {
+        std::string label = in.bytes(16);
+        label.resize(std::min(label.size(), label.find('\0'))); // Drop NUL padding
+        double open = in.f64le(), high = in.f64le(), low = in.f64le(), close = in.f64le();
+        candles.emplace_back(label, open, high, low, close);
+        Candlestick& c = candles.back();
+        double p5 = in.f64le(), median = in.f64le(), p95 = in.f64le();
+        if (quantiles) {
+            c.hasQuantiles = true;
+            c.p5 = p5;
+            c.median = median;
+            c.p95 = p95;
+        }
+        c.count = (long)in.u64le();
+        c.anomalies = (int)in.u32le();
+        in.u32le();                            // Reserved
+    }
+    return in.ok();
+}
+
+ExportFormat CandleExporter::formatFromName(const std::string& name) {
+    if (name == "csv") return ExportFormat::CSV;
+    if (name == "ndjson" || name == "json") return ExportFormat::NDJSON;
+    if (name == "bin" || name == "binary") return ExportFormat::BINARY;
+    throw std::runtime_error("Unknown export format " + name);
+}
@@ -0,0 +1,38 @@
+#ifndef CANDLEEXPORTER_H
+#define CANDLEEXPORTER_H
+#include <string>
+#include <vector>
+#include "Candlestick.h"
+class BufferedWriter;
+class ByteReader;
+
+enum class ExportFormat { CSV, NDJSON, BINARY }; // Output encodings
+
+// Writes candles (with count, quantile and anomaly fields) for downstream
+// tools.
+//
+// CSV:    header period,open,high,low,close,count,p5,median,p95,anomalies;
+//         quantile cells are empty when not computed.
+// NDJSON: one object per line with the same keys; quantile keys omitted
+//         when not computed.
+// BINARY: little-endian. 24-byte header: "WTCANDL1", u32 version (1),
+//         u32 flags (bit 0: quantiles present), u64 record count. Then
+//         88-byte records: char period[16] (NUL-padded), f64 open, high,
+//         low, close, p5, median, p95 (NaN when absent), i64 count,
+//         i32 anomalies, u32 reserved (0).
+class CandleExporter {
+public:
+    // Write candles to `path` ("-" for stdout)
+    static void write(const std::string& path,
+                      const std::vector<Candlestick>& candles,
+                      ExportFormat format);
+
+    // The BINARY encoding on its own, for files that embed candles
+    // (the result cache); readBinary returns false on a malformed block
+    static void writeBinary(BufferedWriter& out, const std::vector<Candlestick>& candles);
+    static bool readBinary(ByteReader& in, std::vector<Candlestick>& candles);
+
+    // Pick a format from a name (csv, ndjson, json, bin, binary)
+    static ExportFormat formatFromName(const std::string& name);
+};
+#endif // CANDLEEXPORTER_H
@@ -9,6 +9,12 @@ public:
     double high;                                 // Maximum temperature
     double low;                                  // Minimum temperature
     double close;                                // Closing temperature
+    long count    = 0;                           // Readings in the period
+    bool hasQuantiles = false;                   // Quantile fields below set?
+    double p5     = 0;                           // 5th percentile
+    double median = 0;                           // 50th percentile
+    double p95    = 0;                           // 95th percentile
+    int anomalies = 0;                           // Flagged readings in period
 
     // Constructor initializes all members
     Candlestick(const std::string& period,       // Period label
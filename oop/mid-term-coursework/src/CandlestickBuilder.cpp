@@ -1,40 +1,41 @@
 #include "CandlestickBuilder.h"
 #include <map>                                   // For grouping
-#include <algorithm>                             // For sort
+#include "PeriodAggregate.h"                     // Mergeable partial candle
+
+int CandlestickBuilder::keyLength(Period period) {
+    return (period == Period::YEAR)  ? 4             // YYYY
+         : (period == Period::MONTH) ? 7             // YYYY-MM
+         : 10;                                       // YYYY-MM-DD
+}
 
 std::vector<Candlestick> CandlestickBuilder::build(
     const std::vector<WeatherRecord>& data,
-    Period period) {
-    std::map<std::string, std::vector<WeatherRecord>> groups; // Map period->records
-    int len = (period == Period::YEAR)  ? 4             // YYYY
-            : (period == Period::MONTH) ? 7             // YYYY-MM
-            : 10;                                    // YYYY-MM-DD
-
-    for (auto& r : data)                         // Group records
-        if ((int)r.timestamp.size() >= len)
-            groups[r.timestamp.substr(0, len)].push_back(r);
+    Period period,
+    bool quantiles) {
+    std::map<std::string, PeriodAggregate, std::less<>> groups; // Map period->partial candle
+    std::size_t len = keyLength(period);
 
-    std::vector<Candlestick> candles;            // Output candles
-    for (auto& kv : groups) {
-        auto recs = kv.second;                    // Copy group
-        std::sort(recs.begin(), recs.end(),       // Sort by timestamp
-                  [](const WeatherRecord& a, const WeatherRecord& b) {
-                      return a.timestamp < b.timestamp;
-                  });
-        double open  = recs.front().temperature; // First record temp
-        double close = recs.back().temperature;  // Last record temp
-        double high  = open;                    // Init high
-        double low   = open;                    // Init low
-        for (auto& r : recs) {                  // Compute high/low
-            if (r.temperature > high) high = r.temperature;
-            if (r.temperature < low)  low  = r.temperature;
+    PeriodAggregate* agg = nullptr;              // Group of the previous record
+    std::string_view lastKey;
+    for (auto& r : data) {                       // Single pass over records
+        if (r.timestamp.size() < len) continue;
+        std::string_view key = r.timestamp.substr(0, len);
+        if (!agg || key != lastKey) {            // Sorted input rarely switches
+            auto it = groups.find(key);
+            if (it == groups.end())
+                it = groups.emplace(std::string(key), PeriodAggregate()).first;
+            agg = &it->second;
+            agg->quantiles = quantiles;
+            lastKey = key;
         }
-        candles.emplace_back(kv.first, open, high, low, close); // Store
+        agg->add(r.timestamp, r.temperature);    // Track open/high/low/close
     }
 
-    std::sort(candles.begin(), candles.end(),   // Sort candles by period
-              [](const Candlestick& a, const Candlestick& b) {
-                  return a.period < b.period;
-              });
+    std::vector<Candlestick> candles;            // Output candles
+    candles.reserve(groups.size());
+    for (auto& kv : groups) {                    // Map is already period-sorted
+        kv.second.period = kv.first;
+        candles.push_back(kv.second.toCandle());
+    }
     return candles;                             // Return result
 }
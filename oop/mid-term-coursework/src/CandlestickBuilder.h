@@ -11,6 +11,10 @@ public:
     // Build candlesticks grouped by period
     static std::vector<Candlestick> build(
         const std::vector<WeatherRecord>& data, // Input data
-        Period period);                        // Grouping period
+        Period period,                         // Grouping period
+        bool quantiles = false);               // Add p5/median/p95 fields
+
+    // Length of the timestamp prefix that labels a period
+    static int keyLength(Period period);
 };
 #endif // CANDLESTICKBUILDER_H
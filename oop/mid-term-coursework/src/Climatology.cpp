@@ -0,0 +1,210 @@
+#include "Climatology.h"
+#include <algorithm>                             // For std::max, std::min
+#include <atomic>                                // Work-item counter
+#include <cmath>                                 // For sqrt, isnan
+#include <cstdio>                                // For rename, remove
+#include <functional>                            // For std::function
+#include <limits>                                // For quiet_NaN
+#include <stdexcept>
+#include <thread>                                // Worker pool for build
+#include "BufferedWriter.h"                      // Little-endian cache output
+#include "ByteReader.h"
+#include "MultiFileLoader.h"                     // Merged input table
+
+namespace {
+
+const char kMagic[8] = {'W', 'T', 'C', 'L', 'I', 'M', '0', '1'};
+const std::uint32_t kVersion = 1;
+const int kCells = Climatology::kDays * Climatology::kHours;
+
+// First day of each month in a leap year (0-based)
+const int kMonthStart[12] = {0, 31, 60, 91, 121, 152, 182, 213, 244, 274, 305, 335};
+
+// Cell index (day * 24 + hour) of a YYYY-MM-DDTHH... timestamp, or -1
+int cellOf(std::string_view ts) {
+    if (ts.size() < 13) return -1;
+    auto two = [&](std::size_t p) {
+        char a = ts[p], b = ts[p + 1];
+        if (a < '0' || a > '9' || b < '0' || b > '9') return -1;
+        return (a - '0') * 10 + (b - '0');
+    };
+    int m = two(5), d = two(8), h = two(11);
+    if (m < 1 || m > 12 || d < 1 || d > 31 || h < 0 || h > 23) return -1;
+    return (kMonthStart[m - 1] + d - 1) * Climatology::kHours + h;
+}
+
+// Raw per-cell sums for one country
+struct Sums {
+    std::vector<double> n, s, ss;
+    Sums() : n(kCells, 0.0), s(kCells, 0.0), ss(kCells, 0.0) {}
+};
+
+} // namespace
+
+Climatology Climatology::build(const std::vector<std::string>& files) {
+    Climatology clim;
+    for (auto& f : files) clim.sources.push_back(FileIdentity::of(f));
+
+    // One merged table (duplicate timestamps across files count once),
+    // then work items of (column, row chunk) pulled by the threads; with
+    // chunks = ceil(threads / columns) even a single column keeps every
+    // thread busy. Each item sums into its own Sums, nothing is shared.
+    WeatherTable t = MultiFileLoader::loadTable(files, {});
+    clim.countries = t.countries;
+    std::size_t rows = t.timestamps.size(), cols = t.columns.size();
+    std::size_t threads = std::max(1u, std::thread::hardware_concurrency());
+    std::size_t chunks = cols == 0 ? 1 : (threads + cols - 1) / cols;
+    chunks = std::max<std::size_t>(1, std::min(chunks, rows));
+    std::size_t chunkRows = (rows + chunks - 1) / std::max<std::size_t>(1, chunks);
+
+    std::vector<int> cell(rows);
+    std::vector<Sums> partial(cols * chunks);
+    auto run = [&](std::size_t items, const std::function<void(std::size_t)>& item) {
+        std::atomic<std::size_t> nextItem(0);
+        auto worker = [&] {
+            for (std::size_t i; (i = nextItem++) < items; ) item(i);
+        };
+        std::vector<std::thread> pool;
+        for (std::size_t i = 1; i < std::min(threads, items); ++i) pool.emplace_back(worker);
+        worker();
+        for (auto& th : pool) th.join();
+    };
+    run(chunks, [&](std::size_t k) {          // Cell of every row, by chunk
+        std::size_t end = std::min(rows, (k + 1) * chunkRows);
+        for (std::size_t r = k * chunkRows; r < end; ++r) cell[r] = cellOf(t.timestamps[r]);
+    });
+    run(cols * chunks, [&](std::size_t i) {   // Item i = column i / chunks
+        std::size_t k = i % chunks, end = std::min(rows, (k + 1) * chunkRows);
+        const std::vector<float>& col = t.columns[i / chunks];
+        Sums& acc = partial[i];
+        for (std::size_t r = k * chunkRows; r < end; ++r) {
+            if (cell[r] < 0 || std::isnan(col[r])) continue;
+            double v = col[r];
+            acc.n[cell[r]] += 1;
+            acc.s[cell[r]] += v;
+            acc.ss[cell[r]] += v * v;
+        }
+    });
+
+    // Merge the chunks of each column in chunk order, so the result does
+    // not depend on which thread ran which item
+    std::vector<Sums> total(cols);
+    for (std::size_t i = 0; i < partial.size(); ++i) {
+        Sums& to = total[i / chunks];
+        for (int x = 0; x < kCells; ++x) {
+            to.n[x] += partial[i].n[x];
+            to.s[x] += partial[i].s[x];
+            to.ss[x] += partial[i].ss[x];
+        }
+    }
+
+    // Pool each cell with the same hour of the neighbouring days
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    for (auto& sums : total) {
+        std::vector<Cell> out(kCells);
+        for (int day = 0; day < kDays; ++day)
+            for (int h = 0; h < kHours; ++h) {
+                double n = 0, s = 0, ss = 0;
+                for (int k = -kHalfWindow; k <= kHalfWindow; ++k) {
+                    int x = ((day + k + kDays) % kDays) * kHours + h;
+                    n += sums.n[x];
+                    s += sums.s[x];
+                    ss += sums.ss[x];
+                }
+                Cell& c = out[day * kHours + h];
+                c.count = (unsigned)n;
+                c.mean = n > 0 ? s / n : nan;
+                c.sd = n > 1 ? std::sqrt(std::max(0.0, (ss - s * s / n) / (n - 1))) : nan;
+            }
+        clim.cells.push_back(std::move(out));
+    }
+    return clim;
+}
+
+Climatology Climatology::loadOrBuild(const std::vector<std::string>& files) {
+    std::vector<FileIdentity> ids;
+    for (auto& f : files) ids.push_back(FileIdentity::of(f));
+    std::string path = files.at(0) + ".clim";
+    Climatology clim;
+    if (clim.load(path, ids)) return clim;
+    clim = build(files);
+    try {
+        clim.save(path);
+    } catch (const std::runtime_error&) {
+        // A read-only data directory only means the next run rebuilds
+    }
+    return clim;
+}
+
+void Climatology::save(const std::string& path) const {
+    // Written under a temporary name and renamed, so a concurrent reader
+    // never sees a half-written baseline
+    std::string tmp = path + ".tmp";
+    {
+        BufferedWriter out(tmp);
+        out.put(kMagic, sizeof kMagic);
+        out.u32le(kVersion);
+        out.u32le((std::uint32_t)sources.size());
+        for (auto& s : sources) s.write(out);
+        out.u32le((std::uint32_t)countries.size());
+        for (auto& c : countries) out.str(c);
+        for (auto& country : cells)
+            for (auto& c : country) {
+                out.f64le(c.mean);
+                out.f64le(c.sd);
+                out.u32le(c.count);
+                out.u32le(0);                  // Reserved
+            }
+    }
+    if (std::rename(tmp.c_str(), path.c_str()) != 0) {
+        std::remove(tmp.c_str());
+        throw std::runtime_error("Cannot write " + path);
+    }
+}
+
+bool Climatology::load(const std::string& path,
+                       const std::vector<FileIdentity>& expected) {
+    ByteReader in(path);
+    if (!in.expect(kMagic, sizeof kMagic) || in.u32le() != kVersion
+        || in.u32le() != expected.size())
+        return false;
+    Climatology clim;
+    for (auto& id : expected) {
+        clim.sources.push_back(FileIdentity::read(in));
+        if (!in.ok() || clim.sources.back() != id) return false; // Other or older inputs
+    }
+    std::size_t n = in.u32le();
+    for (std::size_t i = 0; i < n && in.ok(); ++i) clim.countries.push_back(in.str());
+    if (!in.ok() || in.remaining() != n * kCells * 24) return false;
+    clim.cells.assign(n, std::vector<Cell>(kCells));
+    for (auto& country : clim.cells)
+        for (auto& c : country) {
+            c.mean = in.f64le();
+            c.sd = in.f64le();
+            c.count = in.u32le();
+            in.u32le();                        // Reserved
+        }
+    *this = std::move(clim);
+    return true;
+}
+
+void Climatology::departures(WeatherDataset& data, const std::string& country,
+                             bool standardise) const {
+    std::size_t k = 0;
+    while (k < countries.size() && countries[k] != country) ++k;
+    if (k == countries.size())
+        throw std::runtime_error("No baseline for " + country);
+    const std::vector<Cell>& normals = cells[k];
+    std::size_t kept = 0;
+    for (auto& r : data.records) {
+        int x = cellOf(r.timestamp);
+        if (x < 0 || normals[x].count == 0) continue;
+        const Cell& c = normals[x];
+        if (standardise && !(c.sd > 0)) continue;
+        WeatherRecord d = r;
+        d.temperature = standardise ? (r.temperature - c.mean) / c.sd
+                                    : r.temperature - c.mean;
+        data.records[kept++] = d;
+    }
+    data.records.resize(kept);
+}
@@ -0,0 +1,54 @@
+#ifndef CLIMATOLOGY_H
+#define CLIMATOLOGY_H
+#include <string>
+#include <vector>
+#include "FileIdentity.h"                     // Source files of a baseline
+#include "WeatherLoader.h"                    // For WeatherDataset
+
+// Climatological normals: for every country in the input files, the mean
+// and standard deviation of temperature by calendar day x hour of day
+// (366 x 24 cells, 29 February has its own day). Each cell pools the same
+// hour over a +-7 day window so a few years of data give stable normals.
+//
+// A baseline is built once per set of input files and cached next to the
+// first file as <file>.clim; later runs read the cache, whatever country
+// they ask for, until one of the input files changes.
+class Climatology {
+public:
+    static const int kDays = 366;              // Calendar days, leap year layout
+    static const int kHours = 24;
+    static const int kHalfWindow = 7;          // Days pooled either side
+
+    // Normal for one cell
+    struct Cell {
+        double mean = 0;
+        double sd = 0;                         // NaN with fewer than 2 readings
+        unsigned count = 0;                    // Readings pooled into the cell
+    };
+
+    // Build from all temperature columns of the files, merged by timestamp
+    // as MultiFileLoader::loadTable does (a reading repeated in several
+    // files counts once). The columns are split into row chunks that the
+    // threads take as work items; the items' sums are merged in a fixed order.
+    static Climatology build(const std::vector<std::string>& files);
+
+    // Read the cached baseline for these files, or build and cache it
+    static Climatology loadOrBuild(const std::vector<std::string>& files);
+
+    // Binary cache; load returns false if the file is missing, corrupt or
+    // was built from different (or since modified) input files
+    void save(const std::string& path) const;
+    bool load(const std::string& path, const std::vector<FileIdentity>& expected);
+
+    // Replace each reading by its departure from normal, in degrees or, if
+    // `standardise`, in standard deviations; readings without a usable
+    // normal are dropped. Throws if the country has no baseline.
+    void departures(WeatherDataset& data, const std::string& country,
+                    bool standardise) const;
+
+private:
+    std::vector<FileIdentity> sources;         // Inputs the baseline came from
+    std::vector<std::string> countries;
+    std::vector<std::vector<Cell>> cells;      // Per country, kDays * kHours
+};
+#endif // CLIMATOLOGY_H
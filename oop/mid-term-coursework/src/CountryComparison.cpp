@@ -0,0 +1,179 @@
+#include "CountryComparison.h"
+#include <algorithm>                             // For min
+#include <atomic>                                // Tile counter
+#include <cmath>                                 // For isnan, sqrt, round
+#include <iomanip>                               // For setw
+#include <iostream>                              // For std::cout
+#include <thread>                                // Worker threads
+
+namespace {
+const std::size_t kRowBlock = 2048;           // Rows per cache block
+const std::size_t kTile     = 8;              // Columns per matrix tile
+
+// Masked column ready for dot products: centred values (0 where missing),
+// their squares and a 0/1 presence mask, all contiguous floats
+struct Prepared {
+    std::vector<float> x, x2, m;
+};
+
+Prepared prepare(const std::vector<float>& col) {
+    double sum = 0;
+    std::size_t n = 0;
+    for (float v : col)
+        if (!std::isnan(v)) { sum += v; ++n; }
+    float mean = n ? (float)(sum / n) : 0.0f; // Centring limits cancellation
+    Prepared p;
+    p.x.resize(col.size());
+    p.x2.resize(col.size());
+    p.m.resize(col.size());
+    for (std::size_t i = 0; i < col.size(); ++i) {
+        bool ok = !std::isnan(col[i]);
+        float c = ok ? col[i] - mean : 0.0f;
+        p.x[i] = c;
+        p.x2[i] = c * c;
+        p.m[i] = ok ? 1.0f : 0.0f;
+    }
+    return p;
+}
+
+// Dot product over [begin, end) with eight independent float lanes so the
+// compiler can keep it in SIMD registers; callers keep ranges short (one
+// row block) and accumulate the block results in double
+double dot(const float* a, const float* b, std::size_t begin, std::size_t end) {
+    float acc[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+    std::size_t i = begin;
+    for (; i + 8 <= end; i += 8)
+        for (int l = 0; l < 8; ++l) acc[l] += a[i + l] * b[i + l];
+    double total = 0;
+    for (int l = 0; l < 8; ++l) total += acc[l];
+    for (; i < end; ++i) total += a[i] * b[i];
+    return total;
+}
+
+// Pearson correlation from pairwise-complete sums
+double pearson(double n, double sx, double sy, double sxx, double syy, double sxy) {
+    if (n < 2) return NAN;
+    double cov = sxy - sx * sy / n;
+    double vx = sxx - sx * sx / n;
+    double vy = syy - sy * sy / n;
+    return (vx > 0 && vy > 0) ? cov / std::sqrt(vx * vy) : NAN;
+}
+}
+
+std::vector<double> CountryComparison::pearsonMatrix(const WeatherTable& table,
+                                                     unsigned threads) {
+    std::size_t n = table.columns.size();
+    std::size_t rows = table.timestamps.size();
+    std::vector<Prepared> cols(n);
+    for (std::size_t c = 0; c < n; ++c) cols[c] = prepare(table.columns[c]);
+
+    std::vector<double> matrix(n * n, 1.0);
+    std::size_t tiles = (n + kTile - 1) / kTile;
+    std::vector<std::pair<std::size_t, std::size_t>> work; // Upper-triangle tiles
+    for (std::size_t ti = 0; ti < tiles; ++ti)
+        for (std::size_t tj = ti; tj < tiles; ++tj) work.push_back({ti, tj});
+
+    std::atomic<std::size_t> next(0);
+    auto worker = [&]() {
+        std::vector<double> acc;               // Six sums per pair in the tile
+        for (std::size_t w; (w = next++) < work.size();) {
+            std::size_t i0 = work[w].first * kTile, i1 = std::min(n, i0 + kTile);
+            std::size_t j0 = work[w].second * kTile, j1 = std::min(n, j0 + kTile);
+            acc.assign(kTile * kTile * 6, 0.0);
+            // Row blocks outermost so each column segment stays in cache
+            // while every pair in the tile uses it
+            for (std::size_t r0 = 0; r0 < rows; r0 += kRowBlock) {
+                std::size_t r1 = std::min(rows, r0 + kRowBlock);
+                for (std::size_t i = i0; i < i1; ++i)
+                    for (std::size_t j = std::max(j0, i + 1); j < j1; ++j) {
+                        const Prepared& a = cols[i];
+                        const Prepared& b = cols[j];
+                        double* s = &acc[((i - i0) * kTile + (j - j0)) * 6];
+                        s[0] += dot(a.m.data(),  b.m.data(),  r0, r1); // n
+                        s[1] += dot(a.x.data(),  b.m.data(),  r0, r1); // sx
+                        s[2] += dot(a.m.data(),  b.x.data(),  r0, r1); // sy
+                        s[3] += dot(a.x2.data(), b.m.data(),  r0, r1); // sxx
+                        s[4] += dot(a.m.data(),  b.x2.data(), r0, r1); // syy
+                        s[5] += dot(a.x.data(),  b.x.data(),  r0, r1); // sxy
+                    }
+            }
+            for (std::size_t i = i0; i < i1; ++i)
+                for (std::size_t j = std::max(j0, i + 1); j < j1; ++j) {
+                    double* s = &acc[((i - i0) * kTile + (j - j0)) * 6];
+                    double r = pearson(s[0], s[1], s[2], s[3], s[4], s[5]);
+                    matrix[i * n + j] = matrix[j * n + i] = r;
+                }
+        }
+    };
+
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = (unsigned)std::min<std::size_t>(threads, work.size());
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < threads; ++t) pool.emplace_back(worker);
+    worker();                                  // Calling thread works too
+    for (auto& t : pool) t.join();
+    return matrix;
+}
+
+std::vector<double> CountryComparison::crossCorrelation(const std::vector<float>& x,
+                                                        const std::vector<float>& y,
+                                                        int maxLag) {
+    Prepared a = prepare(x), b = prepare(y);
+    std::size_t rows = std::min(x.size(), y.size());
+    std::vector<double> out;
+    for (int lag = -maxLag; lag <= maxLag; ++lag) {
+        // Pair x[t] with y[t + lag] by offsetting the two base pointers
+        std::size_t ax = lag < 0 ? -lag : 0, by = lag > 0 ? lag : 0;
+        std::size_t len = rows > (std::size_t)std::abs(lag) ? rows - std::abs(lag) : 0;
+        double s[6] = {0, 0, 0, 0, 0, 0};
+        for (std::size_t r0 = 0; r0 < len; r0 += kRowBlock) {
+            std::size_t r1 = std::min(len, r0 + kRowBlock);
+            s[0] += dot(a.m.data() + ax,  b.m.data() + by,  r0, r1);
+            s[1] += dot(a.x.data() + ax,  b.m.data() + by,  r0, r1);
+            s[2] += dot(a.m.data() + ax,  b.x.data() + by,  r0, r1);
+            s[3] += dot(a.x2.data() + ax, b.m.data() + by,  r0, r1);
+            s[4] += dot(a.m.data() + ax,  b.x2.data() + by, r0, r1);
+            s[5] += dot(a.x.data() + ax,  b.x.data() + by,  r0, r1);
+        }
+        out.push_back(pearson(s[0], s[1], s[2], s[3], s[4], s[5]));
+    }
+    return out;
+}
+
+WeatherDataset CountryComparison::difference(const WeatherDataset& a,
+                                             const WeatherDataset& b) {
+    WeatherDataset out;
+    if (a.records.empty() || b.records.empty()) return out;
+    std::string_view label = out.strings.intern(std::string(a.records[0].country) + "-"
+                                                + std::string(b.records[0].country));
+    // Merge join on the sorted timestamps
+    std::size_t i = 0, j = 0;
+    while (i < a.records.size() && j < b.records.size()) {
+        const WeatherRecord& ra = a.records[i];
+        const WeatherRecord& rb = b.records[j];
+        if (ra.timestamp < rb.timestamp) { ++i; continue; }
+        if (rb.timestamp < ra.timestamp) { ++j; continue; }
+        // Readings have a few decimals; rounding to 1e-9 drops the binary
+        // residue of the subtraction (-5.122999999999999 becomes -5.123)
+        double d = std::round((ra.temperature - rb.temperature) * 1e9) / 1e9;
+        out.records.push_back({out.strings.store(ra.timestamp), label, d});
+        ++i;
+        ++j;
+    }
+    return out;
+}
+
+void CountryComparison::printMatrix(const WeatherTable& table,
+                                    const std::vector<double>& matrix) {
+    std::size_t n = table.countries.size();
+    std::cout << std::setw(6) << "";
+    for (auto& c : table.countries) std::cout << std::setw(7) << c;
+    std::cout << '\n' << std::fixed << std::setprecision(3);
+    for (std::size_t i = 0; i < n; ++i) {
+        std::cout << std::setw(6) << table.countries[i];
+        for (std::size_t j = 0; j < n; ++j) std::cout << std::setw(7) << matrix[i * n + j];
+        std::cout << '\n';
+    }
+    std::cout.unsetf(std::ios::floatfield);     // Restore default formatting
+    std::cout << std::setprecision(6);
+}
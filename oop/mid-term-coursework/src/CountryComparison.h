@@ -0,0 +1,32 @@
+#ifndef COUNTRYCOMPARISON_H
+#define COUNTRYCOMPARISON_H
+#include <string>
+#include <vector>
+#include "WeatherLoader.h"                    // For WeatherTable, WeatherRecord
+
+// Cross-country statistics over a WeatherTable. Correlations use pairwise
+// complete observations: each pair only counts rows where both are present.
+class CountryComparison {
+public:
+    // N x N Pearson matrix (row-major). Built from masked, blocked float dot
+    // products; tiles of the matrix are spread over `threads` threads
+    // (0 = hardware concurrency)
+    static std::vector<double> pearsonMatrix(const WeatherTable& table,
+                                             unsigned threads = 0);
+
+    // Correlation of x[t] with y[t + lag] for lag in [-maxLag, maxLag]
+    static std::vector<double> crossCorrelation(const std::vector<float>& x,
+                                                const std::vector<float>& y,
+                                                int maxLag);
+
+    // Readings of a minus readings of b at the timestamps both have; both
+    // must be in time order (as MultiFileLoader::load returns them).
+    // Works on the parsed doubles, not the float table columns
+    static WeatherDataset difference(const WeatherDataset& a,
+                                     const WeatherDataset& b);
+
+    // Print the matrix with country labels
+    static void printMatrix(const WeatherTable& table,
+                            const std::vector<double>& matrix);
+};
+#endif // COUNTRYCOMPARISON_H
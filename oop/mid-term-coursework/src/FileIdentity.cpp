@@ -0,0 +1,33 @@
+#include "FileIdentity.h"
+#include <climits>                               // For PATH_MAX
+#include <cstdlib>                               // For realpath
+#include <stdexcept>
+#include <sys/stat.h>                            // For stat
+#include "BufferedWriter.h"
+#include "ByteReader.h"
+
+FileIdentity FileIdentity::of(const std::string& file) {
+    struct stat st;
+    if (::stat(file.c_str(), &st) != 0)
+        throw std::runtime_error("Cannot stat " + file);
+    char resolved[PATH_MAX];
+    FileIdentity id;
+    id.path = ::realpath(file.c_str(), resolved) ? resolved : file;
+    id.size = (unsigned long long)st.st_size;
+    id.mtime = (long long)st.st_mtim.tv_sec * 1000000000LL + st.st_mtim.tv_nsec;
+    return id;
+}
+
+void FileIdentity::write(BufferedWriter& out) const {
+    out.str(path);
+    out.u64le(size);
+    out.u64le((std::uint64_t)mtime);
+}
+
+FileIdentity FileIdentity::read(ByteReader& in) {
+    FileIdentity id;
+    id.path = in.str();
+    id.size = in.u64le();
+    id.mtime = (long long)in.u64le();
+    return id;
+}
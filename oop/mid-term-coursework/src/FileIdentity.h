@@ -0,0 +1,26 @@
+#ifndef FILEIDENTITY_H
+#define FILEIDENTITY_H
+#include <string>
+class BufferedWriter;
+class ByteReader;
+
+// What a derived file (cache, baseline) remembers about an input so it
+// can tell when the input has changed: canonical path, size and mtime
+struct FileIdentity {
+    std::string path;                          // Canonical absolute path
+    unsigned long long size = 0;               // Bytes
+    long long mtime = 0;                       // Modification time, ns since epoch
+
+    // Identity of a file as it is now; throws if it cannot be stat'ed
+    static FileIdentity of(const std::string& file);
+
+    // Binary form used inside cache files
+    void write(BufferedWriter& out) const;
+    static FileIdentity read(ByteReader& in);
+
+    bool operator==(const FileIdentity& o) const {
+        return size == o.size && mtime == o.mtime && path == o.path;
+    }
+    bool operator!=(const FileIdentity& o) const { return !(*this == o); }
+};
+#endif // FILEIDENTITY_H
@@ -0,0 +1,439 @@
+#include "FilterExpression.h"
+#include <algorithm>                             // For min, max, sort
+#include <cctype>                                // For isdigit, isalpha
+#include <charconv>                              // For to_chars
+#include <cmath>                                 // For nextafter, floor
+#include <cstdio>                                // For snprintf
+#include <limits>                                // For infinity
+#include <memory>                                // For unique_ptr
+#include <stdexcept>
+
+namespace {
+using Conj = FilterExpression::Conjunction;
+using Terms = std::vector<Conj>;
+const std::size_t kMaxTerms = 256;            // Guard against DNF blow-up
+
+enum class Field { YEAR, MONTH, DAY, HOUR, DATE, TEMP };
+
+// Parsed expression tree
+struct Node {
+    enum Kind { AND, OR, NOT, LEAF } kind;
+    std::unique_ptr<Node> lhs, rhs;            // Children (NOT uses lhs)
+    Field field = Field::TEMP;                 // LEAF: field tested
+    double lo = 0, hi = 0;                     // LEAF: inclusive range, or...
+    std::vector<double> set;                   // LEAF: ...set of values
+};
+
+// Simple hand-written lexer + recursive-descent parser
+class Parser {
+public:
+    explicit Parser(const std::string& text) : s(text) {}
+
+    std::unique_ptr<Node> parseAll() {
+        auto n = parseOr();
+        if (!peek().empty()) fail("unexpected '" + peek() + "'");
+        return n;
+    }
+
+private:
+    const std::string& s;
+    std::size_t pos = 0;
+
+    [[noreturn]] void fail(const std::string& msg) {
+        throw std::runtime_error("Bad --where expression: " + msg);
+    }
+
+    static std::string lower(std::string t) {
+        for (auto& c : t) c = (char)std::tolower((unsigned char)c);
+        return t;
+    }
+
+    // Next token without consuming it ("" at end)
+    std::string peek() {
+        std::size_t save = pos;
+        std::string t = next();
+        pos = save;
+        return t;
+    }
+
+    std::string next() {
+        while (pos < s.size() && std::isspace((unsigned char)s[pos])) ++pos;
+        if (pos >= s.size()) return "";
+        std::size_t start = pos;
+        char c = s[pos];
+        if (c == '\'' || c == '"') {             // Quoted literal (dates)
+            std::size_t end = s.find(c, pos + 1);
+            if (end == std::string::npos) fail("unterminated string");
+            pos = end + 1;
+            return s.substr(start + 1, end - start - 1);
+        }
+        if (std::isdigit((unsigned char)c) || c == '.'
+            || (c == '-' && pos + 1 < s.size() && std::isdigit((unsigned char)s[pos + 1]))) {
+            ++pos;                             // Number or bare YYYY-MM-DD
+            while (pos < s.size() && (std::isdigit((unsigned char)s[pos])
+                                      || s[pos] == '.' || s[pos] == '-'))
+                ++pos;
+        } else if (std::isalpha((unsigned char)c) || c == '_') {
+            while (pos < s.size() && (std::isalnum((unsigned char)s[pos]) || s[pos] == '_'))
+                ++pos;
+            return lower(s.substr(start, pos - start));
+        } else if ((c == '<' || c == '>' || c == '!' || c == '=')
+                   && pos + 1 < s.size() && s[pos + 1] == '=') {
+            pos += 2;                          // Two-character operator
+        } else {
+            ++pos;                             // Single character
+        }
+        return s.substr(start, pos - start);
+    }
+
+    void expect(const std::string& t) {
+        if (next() != t) fail("expected '" + t + "'");
+    }
+
+    std::unique_ptr<Node> binary(Node::Kind k, std::unique_ptr<Node> a,
+                                 std::unique_ptr<Node> b) {
+        auto n = std::make_unique<Node>();
+        n->kind = k;
+        n->lhs = std::move(a);
+        n->rhs = std::move(b);
+        return n;
+    }
+
+    std::unique_ptr<Node> negate(std::unique_ptr<Node> a) {
+        auto n = std::make_unique<Node>();
+        n->kind = Node::NOT;
+        n->lhs = std::move(a);
+        return n;
+    }
+
+    std::unique_ptr<Node> parseOr() {
+        auto n = parseAnd();
+        while (peek() == "or") { next(); n = binary(Node::OR, std::move(n), parseAnd()); }
+        return n;
+    }
+
+    std::unique_ptr<Node> parseAnd() {
+        auto n = parseUnary();
+        while (peek() == "and") { next(); n = binary(Node::AND, std::move(n), parseUnary()); }
+        return n;
+    }
+
+    std::unique_ptr<Node> parseUnary() {
+        std::string t = peek();
+        if (t == "not") { next(); return negate(parseUnary()); }
+        if (t == "(") {
+            next();
+            auto n = parseOr();
+            expect(")");
+            return n;
+        }
+        return parseComparison();
+    }
+
+    // A literal for field f; values outside the field's domain (month 13,
+    // hour -1, a fractional day, ...) are errors rather than empty filters
+    double value(Field f) {
+        std::string t = next();
+        if (t.empty()) fail("missing value");
+        double v;
+        try {
+            if (f == Field::DATE) {            // YYYY-MM-DD -> YYYYMMDD
+                if (t.size() != 10 || t[4] != '-' || t[7] != '-') fail("bad date " + t);
+                double m = std::stod(t.substr(5, 2)), d = std::stod(t.substr(8, 2));
+                if (m < 1 || m > 12 || d < 1 || d > 31) fail("bad date " + t);
+                return std::stod(t.substr(0, 4)) * 10000 + m * 100 + d;
+            }
+            std::size_t used = 0;
+            v = std::stod(t, &used);
+            if (used != t.size()) fail("bad number " + t);
+        } catch (const std::logic_error&) {
+            fail("bad value " + t);
+        }
+        if (f == Field::TEMP) return v;
+        static const char* names[] = {"year", "month", "day", "hour"};
+        static const double lo[] = {-1e6, 1, 1, 0}, hi[] = {1e6, 12, 31, 23};
+        int i = (int)f;                        // YEAR..HOUR
+        if (v != std::floor(v) || v < lo[i] || v > hi[i])
+            fail(std::string(names[i]) + " must be a whole number in "
+                 + std::to_string((long)lo[i]) + ".." + std::to_string((long)hi[i])
+                 + ", got " + t);
+        return v;
+    }
+
+    std::unique_ptr<Node> parseComparison() {
+        std::string name = next();
+        auto leaf = std::make_unique<Node>();
+        leaf->kind = Node::LEAF;
+        if      (name == "year")  leaf->field = Field::YEAR;
+        else if (name == "month") leaf->field = Field::MONTH;
+        else if (name == "day")   leaf->field = Field::DAY;
+        else if (name == "hour")  leaf->field = Field::HOUR;
+        else if (name == "date")  leaf->field = Field::DATE;
+        else if (name == "temp" || name == "temperature") leaf->field = Field::TEMP;
+        else fail("unknown field '" + name + "'");
+
+        Field f = leaf->field;
+        const double inf = std::numeric_limits<double>::infinity();
+        bool integral = f != Field::TEMP;      // Strict bounds step by 1
+        auto above = [&](double v) { return integral ? v + 1 : std::nextafter(v, inf); };
+        auto below = [&](double v) { return integral ? v - 1 : std::nextafter(v, -inf); };
+
+        std::string op = next();
+        bool neg = false;
+        if (op == "not") { neg = true; op = next(); }
+        if (op == "in") {
+            expect("(");
+            do leaf->set.push_back(value(f));
+            while (peek() == "," && (next(), true));
+            expect(")");
+        } else if (op == "between") {
+            leaf->lo = value(f);
+            expect("and");
+            leaf->hi = value(f);
+        } else if (neg) {
+            fail("expected 'in' or 'between' after 'not'");
+        } else {
+            double v = value(f);
+            leaf->lo = -inf;
+            leaf->hi = inf;
+            if      (op == "=" || op == "==") leaf->lo = leaf->hi = v;
+            else if (op == "<")  leaf->hi = below(v);
+            else if (op == "<=") leaf->hi = v;
+            else if (op == ">")  leaf->lo = above(v);
+            else if (op == ">=") leaf->lo = v;
+            else if (op == "!=") { leaf->lo = leaf->hi = v; neg = true; }
+            else fail("unknown operator '" + op + "'");
+        }
+        return neg ? negate(std::move(leaf)) : std::move(leaf);
+    }
+};
+
+// Bitmask of values in [lo, hi] (or in `set`) for a small-domain field
+std::uint64_t maskOf(const Node& n) {
+    std::uint64_t m = 0;
+    if (!n.set.empty()) {
+        for (double v : n.set)
+            if (v >= 0 && v < 64 && v == (long)v) m |= 1ull << (long)v;
+        return m;
+    }
+    for (long v = (long)std::max(0.0, std::ceil(n.lo));
+         v < 64 && v <= n.hi; ++v)
+        m |= 1ull << v;
+    return m;
+}
+
+// Conjunction(s) for a single comparison, optionally negated
+Terms leafTerms(const Node& n, bool negated) {
+    Conj base;
+    bool masked = n.field == Field::MONTH || n.field == Field::DAY || n.field == Field::HOUR;
+    if (masked) {                               // Negation is a complement
+        std::uint64_t m = maskOf(n);
+        std::uint64_t& slot = n.field == Field::MONTH ? base.month
+                            : n.field == Field::DAY   ? base.day : base.hour;
+        slot &= negated ? ~m : m;
+        return {base};
+    }
+
+    // Range fields: a set becomes one term per value
+    std::vector<std::pair<double, double>> ranges;
+    if (!n.set.empty()) for (double v : n.set) ranges.push_back({v, v});
+    else                ranges.push_back({n.lo, n.hi});
+    if (negated) {                              // Complement of a union of points
+        std::sort(ranges.begin(), ranges.end());
+        const double inf = std::numeric_limits<double>::infinity();
+        bool integral = n.field != Field::TEMP;
+        std::vector<std::pair<double, double>> gaps;
+        double start = -inf;
+        for (auto& r : ranges) {
+            double end = integral ? r.first - 1 : std::nextafter(r.first, -inf);
+            if (end >= start) gaps.push_back({start, end});
+            start = std::max(start, integral ? r.second + 1 : std::nextafter(r.second, inf));
+        }
+        gaps.push_back({start, inf});
+        ranges = gaps;
+    }
+
+    Terms out;
+    for (auto& r : ranges) {
+        Conj c = base;
+        auto clampL = [](double v) { return (long)std::max(-1e15, std::min(1e15, v)); };
+        if (n.field == Field::YEAR)      { c.yearLo = clampL(r.first); c.yearHi = clampL(r.second); }
+        else if (n.field == Field::DATE) { c.dateLo = clampL(r.first); c.dateHi = clampL(r.second); }
+        else                             { c.tempLo = r.first; c.tempHi = r.second; }
+        if (!c.empty()) out.push_back(c);
+    }
+    return out;
+}
+
+// Flatten a tree into OR-of-AND form, pushing negations down to the leaves
+Terms toTerms(const Node& n, bool negated) {
+    switch (n.kind) {
+    case Node::LEAF:
+        return leafTerms(n, negated);
+    case Node::NOT:
+        return toTerms(*n.lhs, !negated);
+    default:
+        break;
+    }
+    Terms a = toTerms(*n.lhs, negated);
+    Terms b = toTerms(*n.rhs, negated);
+    bool isAnd = (n.kind == Node::AND) != negated; // De Morgan
+    Terms out;
+    if (isAnd) {                                // Cross product of the groups
+        for (auto& x : a)
+            for (auto& y : b) {
+                Conj c = x;
+                c.intersect(y);
+                if (!c.empty()) out.push_back(c);
+            }
+    } else {
+        out = a;
+        out.insert(out.end(), b.begin(), b.end());
+    }
+    if (out.size() > kMaxTerms)
+        throw std::runtime_error("Bad --where expression: too complex");
+    return out;
+}
+
+// Two ASCII digits to an int
+inline int d2(const char* p) { return (p[0] - '0') * 10 + (p[1] - '0'); }
+
+// Parse YYYY[-MM[-DD]] into YYYYMMDD. A partial date is padded with 00 and,
+// as an upper bound, made exclusive, so results match comparing the
+// 'YYYY-MM-DD' prefix as a string; anything else yields `dflt`
+long dateBound(const std::string& d, bool upper, long dflt) {
+    const int widths[3] = {4, 2, 2};
+    long v = 0;
+    std::size_t i = 0;
+    int parts = 0;
+    for (; parts < 3; ++parts) {
+        if (parts > 0) {
+            if (i >= d.size() || d[i] != '-') break;
+            ++i;
+        }
+        if (i + widths[parts] > d.size()) return dflt;
+        long x = 0;
+        for (int k = 0; k < widths[parts]; ++k, ++i) {
+            if (!std::isdigit((unsigned char)d[i])) return dflt;
+            x = x * 10 + (d[i] - '0');
+        }
+        v = v * (parts == 0 ? 1 : 100) + x;
+    }
+    if (i != d.size()) return dflt;
+    for (int p = parts; p < 3; ++p) v *= 100;
+    return (upper && parts < 3) ? v - 1 : v;
+}
+
+// Nearest real date at or after (lo) / at or before (!lo) a YYYYMMDD
+// bound; bounds built from partial dates use day 00 or 99 and match the
+// same rows as the real date they stand for
+long realDate(long v, bool lo) {
+    if (v <= 0 || v >= 100000000L) return v;  // Unbounded sentinels
+    long y = v / 10000, m = v / 100 % 100, d = v % 100;
+    if (lo) {
+        if (m == 0) m = d = 1;
+        else if (m > 12) { ++y; m = d = 1; }
+        else if (d == 0) d = 1;
+        else if (d > 31) { if (++m > 12) { ++y; m = 1; } d = 1; }
+    } else {
+        if (m == 0) { --y; m = 12; d = 31; }
+        else if (m > 12) { m = 12; d = 31; }
+        else if (d > 31) d = 31;
+        else if (d == 0) { if (--m == 0) { --y; m = 12; } d = 31; }
+    }
+    return (y * 100 + m) * 100 + d;
+}
+
+// Shortest text that reads back as the same double
+std::string shortest(double v) {
+    char buf[32];
+    return std::string(buf, std::to_chars(buf, buf + sizeof buf, v).ptr);
+}
+}
+
+bool FilterExpression::Conjunction::empty() const {
+    return month == 0 || day == 0 || hour == 0 || yearLo > yearHi
+        || dateLo > dateHi || tempLo > tempHi;
+}
+
+void FilterExpression::Conjunction::intersect(const Conjunction& o) {
+    month &= o.month;
+    day   &= o.day;
+    hour  &= o.hour;
+    yearLo = std::max(yearLo, o.yearLo); yearHi = std::min(yearHi, o.yearHi);
+    dateLo = std::max(dateLo, o.dateLo); dateHi = std::min(dateHi, o.dateHi);
+    tempLo = std::max(tempLo, o.tempLo); tempHi = std::min(tempHi, o.tempHi);
+}
+
+FilterExpression::FilterExpression() : terms(1) {}
+
+FilterExpression FilterExpression::parse(const std::string& text) {
+    FilterExpression f;
+    f.terms = toTerms(*Parser(text).parseAll(), false);
+    return f;
+}
+
+void FilterExpression::restrictDates(const std::string& from, const std::string& to) {
+    Conj c;
+    c.dateLo = dateBound(from, false, c.dateLo);
+    c.dateHi = dateBound(to, true, c.dateHi);
+    for (auto& t : terms) t.intersect(c);
+}
+
+void FilterExpression::restrictTemp(double minT, double maxT) {
+    Conj c;
+    c.tempLo = minT;
+    c.tempHi = maxT;
+    for (auto& t : terms) t.intersect(c);
+}
+
+std::string FilterExpression::canonical() const {
+    std::vector<std::string> groups;
+    for (const Conj& t : terms) {
+        if (t.empty()) continue;               // Matches nothing either way
+        long lo = realDate(t.dateLo, true), hi = realDate(t.dateHi, false);
+        if (lo > hi) continue;
+        char masks[64];
+        std::snprintf(masks, sizeof masks, "month=%llx day=%llx hour=%llx",
+                      (unsigned long long)t.month, (unsigned long long)t.day,
+                      (unsigned long long)t.hour);
+        groups.push_back(std::string(masks)
+            + " year=" + std::to_string(t.yearLo) + ".." + std::to_string(t.yearHi)
+            + " date=" + std::to_string(lo) + ".." + std::to_string(hi)
+            + " temp=" + shortest(t.tempLo) + ".." + shortest(t.tempHi));
+    }
+    std::sort(groups.begin(), groups.end());   // OR is order-free
+    groups.erase(std::unique(groups.begin(), groups.end()), groups.end());
+    std::string out;
+    for (auto& g : groups) out += (out.empty() ? "" : " | ") + g;
+    return groups.empty() ? "none" : out;
+}
+
+bool FilterExpression::matches(const WeatherRecord& r) const {
+    std::string_view ts = r.timestamp;
+    if (ts.size() < 10) return false;           // No date to test
+    const char* p = ts.data();                  // Decode YYYY-MM-DDTHH once
+    long year  = d2(p) * 100 + d2(p + 2);
+    int  month = d2(p + 5);
+    int  day   = d2(p + 8);
+    int  hour  = ts.size() >= 13 ? d2(p + 11) : 0;
+    long date  = year * 10000 + month * 100 + day;
+    if ((unsigned)month >= 64 || (unsigned)day >= 64 || (unsigned)hour >= 64)
+        return false;                           // Not a timestamp
+    double t = r.temperature;
+    for (auto& c : terms)
+        if ((c.month >> month & 1) && (c.day >> day & 1) && (c.hour >> hour & 1)
+            && year >= c.yearLo && year <= c.yearHi
+            && date >= c.dateLo && date <= c.dateHi
+            && t >= c.tempLo && t <= c.tempHi)
+            return true;
+    return false;
+}
+
+std::vector<WeatherRecord> FilterExpression::apply(
+    const std::vector<WeatherRecord>& data) const {
+    std::vector<WeatherRecord> out;
+    for (auto& r : data)                        // Single fused pass
+        if (matches(r)) out.push_back(r);
+    return out;
+}
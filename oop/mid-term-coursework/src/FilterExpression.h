@@ -0,0 +1,59 @@
+#ifndef FILTEREXPRESSION_H
+#define FILTEREXPRESSION_H
+#include <cstdint>                                  // For uint64_t
+#include <string>
+#include <vector>
+#include "WeatherLoader.h"                          // For WeatherRecord
+
+// Row filter compiled from a small query language, e.g.
+//   month in (6,7,8) and hour between 12 and 16 and temp > 30
+// Fields: year, month, day, hour, date ('YYYY-MM-DD'), temp.
+// Operators: = != < <= > >=, [not] in (...), [not] between .. and ..,
+// and, or, not, parentheses.
+//
+// The expression is parsed once and flattened into a disjunction of
+// conjunctions. Each conjunction is a fixed set of checks: bitmasks for
+// month/day/hour and inclusive ranges for year/date/temp. Evaluating a row
+// decodes its timestamp once and runs those checks, so any filter costs
+// about the same as one hand-written loop.
+class FilterExpression {
+public:
+    FilterExpression();                        // Matches every row
+
+    // Compile an expression; throws std::runtime_error on syntax errors
+    // and on values outside a field's range (month 1..12, day 1..31,
+    // hour 0..23, whole years)
+    static FilterExpression parse(const std::string& text);
+
+    // AND the filter with a date range / temperature range (inclusive)
+    void restrictDates(const std::string& from, const std::string& to);
+    void restrictTemp(double minT, double maxT);
+
+    // Canonical text of the compiled checks, the same for any two spellings
+    // that compile alike (e.g. "temp>30" and "temp > 30", or --to 2020-01
+    // and --to 2020-01-31); used to key cached results
+    std::string canonical() const;
+
+    // True if the record passes
+    bool matches(const WeatherRecord& r) const;
+
+    // Keep only passing records, in one pass
+    std::vector<WeatherRecord> apply(const std::vector<WeatherRecord>& data) const;
+
+    // One AND-group of checks; public so the compiler helpers can build it
+    struct Conjunction {
+        std::uint64_t month = 0x1FFEull;       // Allowed months (bits 1..12)
+        std::uint64_t day   = 0xFFFFFFFEull;   // Allowed days (bits 1..31)
+        std::uint64_t hour  = 0xFFFFFFull;     // Allowed hours (bits 0..23)
+        long yearLo = -1000000, yearHi = 1000000;           // Year range
+        long dateLo = -1000000000L, dateHi = 1000000000L;   // YYYYMMDD range
+        double tempLo = -1e300, tempHi = 1e300;             // Temp range
+
+        bool empty() const;                    // Can never match?
+        void intersect(const Conjunction& o);  // AND another group in
+    };
+
+private:
+    std::vector<Conjunction> terms;            // OR of these groups
+};
+#endif // FILTEREXPRESSION_H
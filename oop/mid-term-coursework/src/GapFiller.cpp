@@ -0,0 +1,82 @@
+#include "GapFiller.h"
+#include <cmath>                                 // For NAN
+#include "TimeUtil.h"                            // Timestamp parsing
+
+WeatherDataset GapFiller::resample(
+    const std::vector<WeatherRecord>& data,
+    FillPolicy policy,
+    GapStats& stats) {
+    stats = GapStats();
+    std::vector<long long> hours;             // Hour index per usable record
+    std::vector<double> temps;
+    hours.reserve(data.size());
+    temps.reserve(data.size());
+    for (auto& r : data) {
+        long long secs;
+        if (!TimeUtil::parse(r.timestamp, secs)) { ++stats.dropped; continue; }
+        long long h = secs >= 0 ? secs / 3600 : -((-secs + 3599) / 3600);
+        if (!hours.empty() && h <= hours.back()) { ++stats.dropped; continue; }
+        hours.push_back(h);
+        temps.push_back(r.temperature);
+    }
+    if (hours.empty()) return WeatherDataset();
+
+    // Scatter readings onto the grid; holes stay NaN
+    long long first = hours.front();
+    std::size_t n = (std::size_t)(hours.back() - first + 1);
+    std::vector<double> v(n, NAN);
+    std::vector<unsigned char> present(n, 0);
+    for (std::size_t i = 0; i < hours.size(); ++i) {
+        v[hours[i] - first] = temps[i];
+        present[hours[i] - first] = 1;
+    }
+
+    stats.gridHours = (long)n;
+    long run = 0;
+    for (std::size_t i = 0; i < n; ++i) {     // Gap statistics
+        if (present[i]) { run = 0; continue; }
+        ++stats.missingHours;
+        if (run++ == 0) ++stats.gaps;
+        if (run > stats.longestGap) stats.longestGap = run;
+    }
+
+    if (stats.missingHours > 0) {
+        // Carry the nearest reading (value and position) in from each side,
+        // so the fill itself is a branch-free element-wise pass
+        std::vector<double> leftV(n), rightV(n), leftI(n), rightI(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            bool p = present[i];
+            leftV[i] = p ? v[i] : leftV[i - 1];   // i = 0 is always present
+            leftI[i] = p ? (double)i : leftI[i - 1];
+        }
+        for (std::size_t i = n; i-- > 0;) {
+            bool p = present[i];
+            rightV[i] = p ? v[i] : rightV[i + 1]; // i = n-1 is always present
+            rightI[i] = p ? (double)i : rightI[i + 1];
+        }
+        std::vector<double> filled(n);
+        if (policy == FillPolicy::PREVIOUS) {
+            for (std::size_t i = 0; i < n; ++i) filled[i] = leftV[i];
+        } else {
+            for (std::size_t i = 0; i < n; ++i) {
+                double span = rightI[i] - leftI[i];
+                double t = (i - leftI[i]) / (span > 0 ? span : 1.0);
+                filled[i] = leftV[i] + (rightV[i] - leftV[i]) * t;
+            }
+        }
+        if (policy == FillPolicy::SEASONAL)   // Same hour yesterday, if known
+            for (std::size_t i = 24; i < n; ++i)
+                if (!present[i]) filled[i] = filled[i - 24];
+        v.swap(filled);
+    }
+
+    WeatherDataset out;
+    out.records.reserve(n);
+    std::string_view country = out.strings.intern(data.front().country);
+    char ts[32];
+    for (std::size_t i = 0; i < n; ++i) {
+        std::size_t len = TimeUtil::format((first + (long long)i) * 3600, ts);
+        out.records.push_back({out.strings.store(std::string_view(ts, len)), country, v[i]});
+    }
+    return out;
+}
@@ -0,0 +1,30 @@
+#ifndef GAPFILLER_H
+#define GAPFILLER_H
+#include <vector>
+#include "WeatherLoader.h"                    // For WeatherRecord
+
+enum class FillPolicy { LINEAR, PREVIOUS, SEASONAL }; // How to fill holes
+
+// What resampling found
+struct GapStats {
+    long gridHours = 0;                        // Hours from first to last reading
+    long missingHours = 0;                     // Hours that had to be filled
+    long gaps = 0;                             // Runs of missing hours
+    long longestGap = 0;                       // Longest run, in hours
+    long dropped = 0;                          // Extra readings in one hour / bad timestamps
+};
+
+class GapFiller {
+public:
+    // Align time-sorted records to a regular hourly grid and fill the
+    // missing hours. LINEAR interpolates between the readings either side,
+    // PREVIOUS carries the last reading forward, SEASONAL copies the same
+    // hour of the previous day (falling back to LINEAR for the first day).
+    // The first reading in each hour is kept; the output is hourly
+    // with timestamps in YYYY-MM-DDTHH:00:00Z form.
+    static WeatherDataset resample(
+        const std::vector<WeatherRecord>& data, // Time-sorted input
+        FillPolicy policy,                     // Fill method
+        GapStats& stats);                      // Filled in on return
+};
+#endif // GAPFILLER_H
@@ -0,0 +1,98 @@
+#include "IndicatorEngine.h"
+#include <algorithm>                             // For std::max
+#include <cmath>                                 // For sqrt, fabs
+#include <iomanip>                               // For setw, setprecision
+#include <iostream>                              // For std::cout
+#include <limits>                                // For quiet_NaN
+#include <stdexcept>
+
+std::vector<IndicatorSeries> IndicatorEngine::compute(
+    const std::vector<Candlestick>& candles,
+    const std::vector<int>& windows,
+    double bandWidth) {
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    std::size_t n = candles.size();
+    std::size_t k = windows.size();
+
+    // Structure-of-arrays copy of the inputs
+    std::vector<double> close(n), high(n), low(n), tr(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        close[i] = candles[i].close;
+        high[i]  = candles[i].high;
+        low[i]   = candles[i].low;
+    }
+
+    std::vector<IndicatorSeries> out(k);
+    for (std::size_t j = 0; j < k; ++j) {
+        if (windows[j] < 1) throw std::invalid_argument("Indicator window must be >= 1");
+        out[j] = {windows[j], std::vector<double>(n, nan), std::vector<double>(n, nan),
+                  std::vector<double>(n, nan), std::vector<double>(n, nan),
+                  std::vector<double>(n, nan)};
+    }
+    // Running state per window, also kept as parallel arrays: a windowed
+    // Welford mean and sum of squared deviations of close, recomputed from
+    // the window once every w candles so rounding cannot build up
+    std::vector<double> mean(k, 0), m2(k, 0), trSum(k, 0), ema(k, 0);
+
+    for (std::size_t i = 0; i < n; ++i) {
+        // True range: the bar's range widened by any gap from the last close
+        tr[i] = (i == 0) ? high[i] - low[i]
+              : std::max({high[i] - low[i], std::fabs(high[i] - close[i - 1]),
+                          std::fabs(low[i] - close[i - 1])});
+        for (std::size_t j = 0; j < k; ++j) {
+            std::size_t w = windows[j];
+            trSum[j] += tr[i];
+            if (i < w) {                        // Growing window
+                double delta = close[i] - mean[j];
+                mean[j] += delta / (i + 1);
+                m2[j] += delta * (close[i] - mean[j]);
+            } else if ((i + 1) % w == 0) {      // Re-base on the exact window
+                double total = 0;
+                for (std::size_t t = i + 1 - w; t <= i; ++t) total += close[t];
+                mean[j] = total / w;
+                m2[j] = 0;
+                for (std::size_t t = i + 1 - w; t <= i; ++t)
+                    m2[j] += (close[t] - mean[j]) * (close[t] - mean[j]);
+            } else {                            // Slide: replace the oldest candle
+                double old = close[i - w];
+                double next = mean[j] + (close[i] - old) / w;
+                m2[j] += (close[i] - old) * (close[i] - next + old - mean[j]);
+                mean[j] = next;
+            }
+            if (i >= w) trSum[j] -= tr[i - w];
+            if (i + 1 < w) continue;            // Window not yet full
+            double var = std::max(0.0, m2[j] / w);
+            if (var <= 1e-12 * mean[j] * mean[j]) var = 0; // Flat series
+            double sd = std::sqrt(var);
+            double alpha = 2.0 / (w + 1);
+            ema[j] = (i + 1 == w) ? mean[j] : ema[j] + alpha * (close[i] - ema[j]);
+            out[j].sma[i]   = mean[j];
+            out[j].ema[i]   = ema[j];
+            out[j].upper[i] = mean[j] + bandWidth * sd;
+            out[j].lower[i] = mean[j] - bandWidth * sd;
+            out[j].atr[i]   = trSum[j] / w;
+        }
+    }
+    return out;
+}
+
+void IndicatorEngine::print(const std::vector<Candlestick>& candles,
+                            const std::vector<IndicatorSeries>& series) {
+    std::cout << std::setw(10) << "period" << std::setw(9) << "close";
+    for (auto& s : series)                      // Header per window
+        for (const char* name : {"SMA", "EMA", "BBlo", "BBhi", "ATR"})
+            std::cout << std::setw(9) << (name + std::to_string(s.window));
+    std::cout << '\n' << std::fixed << std::setprecision(2);
+    for (std::size_t i = 0; i < candles.size(); ++i) {
+        std::cout << std::setw(10) << candles[i].period
+                  << std::setw(9) << candles[i].close;
+        for (auto& s : series)
+            for (double v : {s.sma[i], s.ema[i], s.lower[i], s.upper[i], s.atr[i]}) {
+                if (std::isnan(v)) std::cout << std::setw(9) << "-";
+                else               std::cout << std::setw(9) << v;
+            }
+        std::cout << '\n';
+    }
+    std::cout.unsetf(std::ios::floatfield);     // Restore default formatting
+    std::cout << std::setprecision(6);
+}
@@ -0,0 +1,30 @@
+#ifndef INDICATORENGINE_H
+#define INDICATORENGINE_H
+#include <vector>
+#include "Candlestick.h"
+
+// Indicator columns for one window length, aligned with the candle vector.
+// Entries are NaN until the window has filled.
+struct IndicatorSeries {
+    int window;                                // Window length in candles
+    std::vector<double> sma;                   // Simple moving average of close
+    std::vector<double> ema;                   // Exponential average (SMA seed)
+    std::vector<double> upper;                 // Bollinger upper band
+    std::vector<double> lower;                 // Bollinger lower band
+    std::vector<double> atr;                   // Average true range
+};
+
+class IndicatorEngine {
+public:
+    // Compute every indicator for every window in one fused pass over the
+    // candles (copied into contiguous close/high/low columns first)
+    static std::vector<IndicatorSeries> compute(
+        const std::vector<Candlestick>& candles, // Input candles, in order
+        const std::vector<int>& windows,         // Window lengths
+        double bandWidth = 2.0);                 // Bollinger width in SDs
+
+    // Print one row per candle with the indicator columns
+    static void print(const std::vector<Candlestick>& candles,
+                      const std::vector<IndicatorSeries>& series);
+};
+#endif // INDICATORENGINE_H
@@ -0,0 +1,277 @@
+#include "MultiFileLoader.h"
+#include <glob.h>                                // For POSIX glob()
+#include <algorithm>                             // For stable_sort
+#include <cmath>                                 // For isnan
+#include <exception>                             // For exception_ptr
+#include <functional>                            // For std::function
+#include <limits>                                // For quiet_NaN
+#include <memory>                                // For unique_ptr
+#include <numeric>                               // For iota
+#include <queue>                                 // For the merge heap
+#include <sstream>                               // For splitting the spec
+#include <stdexcept>
+#include <thread>                                // One parser per file
+#include "CsvReader.h"                           // Row cursors for stream()
+
+namespace {
+// Run parse(i) for every file, one thread each (none for a single file),
+// and rethrow the first error on the caller
+void forEachFile(std::size_t k, const std::function<void(std::size_t)>& parse) {
+    std::vector<std::exception_ptr> errors(k);
+    auto run = [&](std::size_t i) {
+        try {
+            parse(i);
+        } catch (...) {
+            errors[i] = std::current_exception();
+        }
+    };
+    if (k == 1) {
+        run(0);
+    } else {
+        std::vector<std::thread> workers;
+        for (std::size_t i = 0; i < k; ++i) workers.emplace_back(run, i);
+        for (auto& t : workers) t.join();
+    }
+    for (auto& e : errors)
+        if (e) std::rethrow_exception(e);
+}
+
+// Put a table's rows in timestamp order (stable, so in-file duplicates
+// keep their order)
+void sortRows(WeatherTable& t) {
+    if (std::is_sorted(t.timestamps.begin(), t.timestamps.end())) return;
+    std::vector<std::size_t> order(t.timestamps.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+        return t.timestamps[a] < t.timestamps[b];
+    });
+    std::vector<std::string_view> ts(order.size());
+    for (std::size_t r = 0; r < order.size(); ++r) ts[r] = t.timestamps[order[r]];
+    t.timestamps.swap(ts);
+    std::vector<float> col(order.size());
+    for (auto& c : t.columns) {
+        for (std::size_t r = 0; r < order.size(); ++r) col[r] = c[order[r]];
+        c.swap(col);
+    }
+}
+}
+
+std::vector<std::string> MultiFileLoader::expandInputs(const std::string& spec) {
+    std::vector<std::string> files;
+    std::stringstream ss(spec);
+    std::string pattern;
+    while (std::getline(ss, pattern, ',')) {  // Comma-separated entries
+        if (pattern.empty()) continue;
+        glob_t g;
+        int rc = glob(pattern.c_str(), 0, nullptr, &g); // Sorted matches
+        if (rc == 0) {
+            for (std::size_t i = 0; i < g.gl_pathc; ++i)
+                files.push_back(g.gl_pathv[i]);
+        } else {
+            files.push_back(pattern);          // Plain path; loader reports errors
+        }
+        globfree(&g);
+    }
+    if (files.empty()) throw std::runtime_error("No input files in " + spec);
+    return files;
+}
+
+WeatherDataset MultiFileLoader::load(
+    const std::vector<std::string>& files,
+    const std::string& country) {
+    auto byTime = [](const WeatherRecord& a, const WeatherRecord& b) {
+        return a.timestamp < b.timestamp;
+    };
+    std::size_t k = files.size();
+    std::vector<WeatherDataset> loaded(k);    // One sorted stream per file
+    forEachFile(k, [&](std::size_t i) {
+        loaded[i] = WeatherLoader::loadCSV(files[i], country);
+        auto& recs = loaded[i].records;
+        if (!std::is_sorted(recs.begin(), recs.end(), byTime))
+            std::stable_sort(recs.begin(), recs.end(), byTime);
+    });
+    if (k == 1) return std::move(loaded[0]);
+
+    std::vector<std::vector<WeatherRecord>> streams(k);
+    WeatherDataset merged;
+    for (std::size_t i = 0; i < k; ++i) {     // Keep every file's strings alive
+        streams[i] = std::move(loaded[i].records);
+        merged.strings.adopt(std::move(loaded[i].strings));
+    }
+
+    // Heap of (stream, position); earliest timestamp, then earliest file, on top
+    using Cursor = std::pair<std::size_t, std::size_t>;
+    auto after = [&](const Cursor& a, const Cursor& b) {
+        const auto& ta = streams[a.first][a.second].timestamp;
+        const auto& tb = streams[b.first][b.second].timestamp;
+        return ta != tb ? ta > tb : a.first > b.first;
+    };
+    std::priority_queue<Cursor, std::vector<Cursor>, decltype(after)> heap(after);
+    std::size_t total = 0;
+    for (std::size_t i = 0; i < k; ++i) {
+        total += streams[i].size();
+        if (!streams[i].empty()) heap.push({i, 0});
+    }
+
+    auto& out = merged.records;
+    out.reserve(total);
+    std::size_t lastFile = k;                   // Stream of the last kept record
+    while (!heap.empty()) {
+        Cursor c = heap.top();
+        heap.pop();
+        auto& r = streams[c.first][c.second];
+        bool dup = !out.empty() && c.first != lastFile
+                   && r.timestamp == out.back().timestamp;
+        if (!dup) {                             // Earlier file already won
+            out.push_back(r);
+            lastFile = c.first;
+        }
+        if (c.second + 1 < streams[c.first].size())
+            heap.push({c.first, c.second + 1});
+    }
+    return merged;
+}
+
+WeatherTable MultiFileLoader::loadTable(
+    const std::vector<std::string>& files,
+    const std::vector<std::string>& countries) {
+    std::size_t k = files.size();
+    std::vector<WeatherTable> loaded(k);      // One sorted table per file
+    forEachFile(k, [&](std::size_t i) {
+        loaded[i] = WeatherLoader::loadTable(files[i], countries);
+        sortRows(loaded[i]);
+    });
+    if (k == 1) return std::move(loaded[0]);
+
+    // Merged column of each file column; the union in first-seen order
+    WeatherTable merged;
+    std::vector<std::vector<std::size_t>> target(k);
+    for (std::size_t i = 0; i < k; ++i)
+        for (auto& c : loaded[i].countries) {
+            std::size_t m = 0;
+            while (m < merged.countries.size() && merged.countries[m] != c) ++m;
+            if (m == merged.countries.size()) merged.countries.push_back(c);
+            target[i].push_back(m);
+        }
+    merged.columns.resize(merged.countries.size());
+
+    // Same heap and duplicate rule as load(), one row at a time
+    using Cursor = std::pair<std::size_t, std::size_t>;
+    auto after = [&](const Cursor& a, const Cursor& b) {
+        const auto& ta = loaded[a.first].timestamps[a.second];
+        const auto& tb = loaded[b.first].timestamps[b.second];
+        return ta != tb ? ta > tb : a.first > b.first;
+    };
+    std::priority_queue<Cursor, std::vector<Cursor>, decltype(after)> heap(after);
+    for (std::size_t i = 0; i < k; ++i)
+        if (!loaded[i].timestamps.empty()) heap.push({i, 0});
+
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    std::size_t lastFile = k;                   // File of the last kept row
+    while (!heap.empty()) {
+        Cursor c = heap.top();
+        heap.pop();
+        const WeatherTable& t = loaded[c.first];
+        std::string_view ts = t.timestamps[c.second];
+        bool dup = lastFile != k && c.first != lastFile
+                   && ts == merged.timestamps.back();
+        if (!dup) {                             // New row, NaN until filled
+            merged.timestamps.push_back(ts);
+            for (auto& col : merged.columns) col.push_back(nan);
+            lastFile = c.first;
+        }
+        for (std::size_t j = 0; j < t.columns.size(); ++j) {
+            float& cell = merged.columns[target[c.first][j]].back();
+            if (std::isnan(cell)) cell = t.columns[j][c.second]; // Earlier file wins
+        }
+        if (c.second + 1 < t.timestamps.size()) heap.push({c.first, c.second + 1});
+    }
+    for (auto& t : loaded) merged.strings.adopt(std::move(t.strings)); // Rows point into them
+    return merged;
+}
+
+void MultiFileLoader::stream(
+    const std::vector<std::string>& files,
+    const std::string& country,
+    std::size_t windowRows,
+    const WeatherLoader::WindowHandler& onWindow) {
+    if (files.size() == 1) {                    // Nothing to merge
+        WeatherLoader::streamCSV(files[0], country, windowRows, onWindow);
+        return;
+    }
+    if (windowRows == 0) windowRows = 1;      // Always make progress
+
+    // One row cursor per file. The current record's timestamp views the
+    // reader's buffer, which stays put until that cursor advances
+    struct Cursor {
+        const std::string* file;
+        std::unique_ptr<csv::Reader> in;
+        csv::RowMapping<WeatherRecord, std::string_view, double> columns;
+        WeatherRecord current{};
+        std::string previous;                  // Last timestamp, for the order check
+
+        bool advance() {
+            while (in->next()) {
+                if (!columns.read(*in, current)) continue; // Same skips as streamCSV
+                if (current.timestamp < previous)
+                    throw std::runtime_error(*file + ": rows are not in time order,"
+                                             " cannot merge it while streaming");
+                previous.assign(current.timestamp.data(), current.timestamp.size());
+                return true;
+            }
+            return false;
+        }
+    };
+    std::size_t k = files.size();
+    std::vector<Cursor> cursors;
+    cursors.reserve(k);
+    for (auto& f : files) {
+        Cursor c{&f, std::make_unique<csv::Reader>(f),
+                 csv::mapping(csv::column("utc_timestamp", &WeatherRecord::timestamp),
+                              csv::column(country + "_temperature",
+                                          &WeatherRecord::temperature)),
+                 {}, {}};
+        c.columns.bind(c.in->readHeader());    // Throws if a column is missing
+        cursors.push_back(std::move(c));
+    }
+
+    // Same ordering and duplicate rule as load(): earliest timestamp, then
+    // earliest file, on top; a later file's reading at the last kept
+    // timestamp is dropped
+    auto after = [&](std::size_t a, std::size_t b) {
+        const auto& ta = cursors[a].current.timestamp;
+        const auto& tb = cursors[b].current.timestamp;
+        return ta != tb ? ta > tb : a > b;
+    };
+    std::priority_queue<std::size_t, std::vector<std::size_t>, decltype(after)> heap(after);
+    for (std::size_t i = 0; i < k; ++i)
+        if (cursors[i].advance()) heap.push(i);
+
+    WeatherDataset window;                    // Current window of records
+    window.records.reserve(windowRows);
+    std::string_view code = window.strings.intern(country);
+    std::string last;                         // Timestamp of the last kept record
+    std::size_t lastFile = k;                 // Its file (k = none yet)
+    while (!heap.empty()) {
+        std::size_t f = heap.top();
+        heap.pop();
+        Cursor& c = cursors[f];
+        bool dup = lastFile != k && f != lastFile && c.current.timestamp == last;
+        if (!dup) {                             // Earlier file already won
+            WeatherRecord r = c.current;
+            r.timestamp = window.strings.store(r.timestamp); // Outlives the cursor
+            r.country = code;
+            window.records.push_back(r);
+            last.assign(r.timestamp.data(), r.timestamp.size());
+            lastFile = f;
+            if (window.records.size() >= windowRows) { // Window full: hand it over
+                onWindow(window);
+                window.records.clear();
+                window.strings.clear();
+                code = window.strings.intern(country);
+            }
+        }
+        if (c.advance()) heap.push(f);
+    }
+    if (!window.records.empty()) onWindow(window); // Flush the final window
+}
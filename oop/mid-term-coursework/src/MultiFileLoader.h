@@ -0,0 +1,46 @@
+#ifndef MULTIFILELOADER_H
+#define MULTIFILELOADER_H
+#include <string>
+#include <vector>
+#include "WeatherLoader.h"                    // For WeatherRecord
+
+// Loads several CSV files (e.g. one per year or region) as one series.
+// Each file is parsed and sorted on its own thread, then the sorted
+// streams are k-way merged by timestamp; files are never concatenated.
+//
+// Duplicate rule: when the same timestamp appears in more than one file,
+// the reading from the file listed first wins and the others are dropped.
+// Duplicates inside a single file are kept as they are. load() and
+// stream() apply the same rule, so both modes see the same readings.
+class MultiFileLoader {
+public:
+    // Expand a comma-separated list of paths and glob patterns
+    // (e.g. "data/*.csv,extra.csv"); each pattern's matches are sorted
+    static std::vector<std::string> expandInputs(const std::string& spec);
+
+    // Load the country column from every file and merge by timestamp
+    static WeatherDataset load(
+        const std::vector<std::string>& files, // Input files, in priority order
+        const std::string& country);           // Country code for column
+
+    // Load several country columns from every file and merge the rows by
+    // timestamp with the same duplicate rule; a later file only fills in
+    // cells the earlier one has no reading for. An empty list takes every
+    // temperature column of every file (missing columns are NaN).
+    static WeatherTable loadTable(
+        const std::vector<std::string>& files, // Input files, in priority order
+        const std::vector<std::string>& countries); // Country codes
+
+    // Bounded-memory variant of load(): the files are read row by row in
+    // parallel cursors and merged by timestamp into windows of at most
+    // windowRows records, so only one window (plus one row per file) is
+    // resident. Unlike load() it cannot sort, so with several files each
+    // must already be in time order (throws otherwise); a single file is
+    // streamed as it is.
+    static void stream(
+        const std::vector<std::string>& files, // Input files, in priority order
+        const std::string& country,            // Country code for column
+        std::size_t windowRows,                // Records per window
+        const WeatherLoader::WindowHandler& onWindow); // Called once per window
+};
+#endif // MULTIFILELOADER_H
@@ -0,0 +1,80 @@
+#include "PeriodAggregate.h"
+#include <stdexcept>                              // For exceptions
+
+namespace {
+// Length-prefixed string helpers for the spill format
+void writeString(std::FILE* out, const std::string& s) {
+    std::size_t n = s.size();
+    std::fwrite(&n, sizeof n, 1, out);
+    std::fwrite(s.data(), 1, n, out);
+}
+
+bool readString(std::FILE* in, std::string& s) {
+    std::size_t n = 0;
+    if (std::fread(&n, sizeof n, 1, in) != 1) return false;
+    s.resize(n);
+    return n == 0 || std::fread(&s[0], 1, n, in) == n;
+}
+}
+
+void PeriodAggregate::add(std::string_view ts, double temp) {
+    if (count == 0) {                          // First reading seeds everything
+        openTs = closeTs = ts;
+        open = high = low = close = temp;
+    } else {
+        if (ts < openTs)   { openTs = ts;  open = temp; }  // Earlier reading
+        if (ts > closeTs)  { closeTs = ts; close = temp; } // Later reading
+        if (temp > high) high = temp;
+        if (temp < low)  low  = temp;
+    }
+    if (quantiles) sketch.add(temp);           // Only pay for it when asked
+    ++count;
+}
+
+void PeriodAggregate::merge(const PeriodAggregate& other) {
+    if (other.count == 0) return;              // Nothing to merge
+    if (count == 0) { *this = other; return; } // Adopt other as-is
+    if (quantiles) sketch.merge(other.sketch);
+    if (other.openTs < openTs)   { openTs = other.openTs;   open = other.open; }
+    if (other.closeTs > closeTs) { closeTs = other.closeTs; close = other.close; }
+    if (other.high > high) high = other.high;
+    if (other.low < low)   low  = other.low;
+    count += other.count;
+}
+
+Candlestick PeriodAggregate::toCandle() const {
+    Candlestick c(period, open, high, low, close);
+    c.count = count;
+    if (quantiles) {                           // Attach distribution summary
+        c.hasQuantiles = true;
+        c.p5     = sketch.quantile(0.05);
+        c.median = sketch.quantile(0.50);
+        c.p95    = sketch.quantile(0.95);
+    }
+    return c;
+}
+
+void PeriodAggregate::write(std::FILE* out) const {
+    writeString(out, period);
+    writeString(out, openTs);
+    writeString(out, closeTs);
+    double v[4] = {open, high, low, close};
+    std::fwrite(v, sizeof(double), 4, out);
+    std::fwrite(&count, sizeof count, 1, out);
+    std::fwrite(&quantiles, sizeof quantiles, 1, out);
+    if (quantiles) sketch.write(out);
+    if (std::ferror(out)) throw std::runtime_error("Failed to write spill file");
+}
+
+bool PeriodAggregate::read(std::FILE* in) {
+    if (!readString(in, period)) return false; // Clean end of file
+    double v[4];
+    if (!readString(in, openTs) || !readString(in, closeTs)
+        || std::fread(v, sizeof(double), 4, in) != 4
+        || std::fread(&count, sizeof count, 1, in) != 1
+        || std::fread(&quantiles, sizeof quantiles, 1, in) != 1
+        || (quantiles && !sketch.read(in)))
+        throw std::runtime_error("Truncated spill file");
+    open = v[0]; high = v[1]; low = v[2]; close = v[3];
+    return true;
+}
@@ -0,0 +1,37 @@
+#ifndef PERIODAGGREGATE_H
+#define PERIODAGGREGATE_H
+#include <cstdio>                                   // For std::FILE
+#include <string>                                   // For std::string
+#include <string_view>                              // For std::string_view
+#include "Candlestick.h"
+#include "QuantileSketch.h"                         // Optional quantile fields
+
+// Partial candle for one period. Keeps the timestamps of its first and
+// last readings so partials built from different chunks merge in any order.
+// On equal timestamps the reading seen (or merged) first is kept.
+struct PeriodAggregate {
+    std::string period;                        // Period label (e.g. 2015-01)
+    std::string openTs;                        // Earliest timestamp seen
+    std::string closeTs;                       // Latest timestamp seen
+    double open  = 0;                          // Temp at openTs
+    double high  = 0;                          // Highest temp
+    double low   = 0;                          // Lowest temp
+    double close = 0;                          // Temp at closeTs
+    long count   = 0;                          // Number of readings
+    bool quantiles = false;                    // Feed the sketch below?
+    QuantileSketch sketch;                     // Distribution (if quantiles)
+
+    // Fold one reading into the aggregate
+    void add(std::string_view ts, double temp);
+
+    // Fold another partial for the same period into this one
+    void merge(const PeriodAggregate& other);
+
+    // Convert to the final candle
+    Candlestick toCandle() const;
+
+    // Binary (de)serialisation used for spill files
+    void write(std::FILE* out) const;
+    bool read(std::FILE* in);                  // False at end of file
+};
+#endif // PERIODAGGREGATE_H
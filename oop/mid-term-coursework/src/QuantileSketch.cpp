@@ -0,0 +1,118 @@
+#include "QuantileSketch.h"
+#include <algorithm>                             // For sort, min, max
+#include <cmath>                                 // For asin, sin
+#include <stdexcept>
+
+namespace {
+const double kPi = 3.14159265358979323846;
+}
+
+QuantileSketch::QuantileSketch(double compression)
+    : compression(compression) {}
+
+void QuantileSketch::add(double x) {
+    if (total == 0) minV = maxV = x;
+    minV = std::min(minV, x);
+    maxV = std::max(maxV, x);
+    ++total;
+    buffer.push_back(x);
+    if (buffer.size() >= 5 * compression) compress(); // Amortised folding
+}
+
+void QuantileSketch::merge(const QuantileSketch& other) {
+    if (other.total == 0) return;
+    if (total == 0) { minV = other.minV; maxV = other.maxV; }
+    minV = std::min(minV, other.minV);
+    maxV = std::max(maxV, other.maxV);
+    total += other.total;
+    for (auto& c : other.centroids)            // Other's centroids as inputs
+        centroids.push_back(c);
+    buffer.insert(buffer.end(), other.buffer.begin(), other.buffer.end());
+    compress();
+}
+
+void QuantileSketch::compress() const {
+    if (buffer.empty() && centroids.size() <= compression) return;
+    std::vector<Centroid> in(centroids);
+    for (double x : buffer) in.push_back({x, 1.0});
+    buffer.clear();
+    std::sort(in.begin(), in.end(),
+              [](const Centroid& a, const Centroid& b) { return a.mean < b.mean; });
+
+    // k1 scale: k(q) = d/(2*pi) * asin(2q - 1); a centroid may span one unit of k
+    double n = 0;
+    for (auto& c : in) n += c.weight;
+    auto qLimit = [&](double q) {
+        double k = compression / (2 * kPi) * std::asin(2 * q - 1) + 1;
+        k = std::min(k, compression / 4);      // asin is bounded by pi/2
+        return (std::sin(2 * kPi * k / compression) + 1) / 2;
+    };
+
+    centroids.clear();
+    Centroid cur = in.front();
+    double soFar = 0;                          // Weight of emitted centroids
+    double limit = n * qLimit(0);
+    for (std::size_t i = 1; i < in.size(); ++i) {
+        if (soFar + cur.weight + in[i].weight <= limit) {
+            cur.weight += in[i].weight;        // Absorb into current centroid
+            cur.mean += (in[i].mean - cur.mean) * in[i].weight / cur.weight;
+        } else {
+            soFar += cur.weight;
+            centroids.push_back(cur);
+            limit = n * qLimit(soFar / n);
+            cur = in[i];
+        }
+    }
+    centroids.push_back(cur);
+}
+
+double QuantileSketch::quantile(double q) const {
+    if (total == 0) return 0;
+    compress();
+    if (q <= 0) return minV;
+    if (q >= 1) return maxV;
+    if (centroids.size() == 1) return centroids.front().mean;
+
+    // Interpolate between centroid centres; ends anchor at the exact extremes
+    double target = q * total;
+    double cum = 0;
+    double prevPos = 0, prevVal = minV;       // Virtual point at the minimum
+    for (auto& c : centroids) {
+        double pos = cum + c.weight / 2;       // Rank of this centroid's centre
+        if (target < pos) {
+            double t = (pos > prevPos) ? (target - prevPos) / (pos - prevPos) : 0;
+            return prevVal + t * (c.mean - prevVal);
+        }
+        prevPos = pos;
+        prevVal = c.mean;
+        cum += c.weight;
+    }
+    double t = (total > prevPos) ? (target - prevPos) / (total - prevPos) : 0;
+    return prevVal + t * (maxV - prevVal);    // Between last centre and max
+}
+
+void QuantileSketch::write(std::FILE* out) const {
+    compress();
+    std::size_t n = centroids.size();
+    std::fwrite(&compression, sizeof compression, 1, out);
+    std::fwrite(&total, sizeof total, 1, out);
+    std::fwrite(&minV, sizeof minV, 1, out);
+    std::fwrite(&maxV, sizeof maxV, 1, out);
+    std::fwrite(&n, sizeof n, 1, out);
+    std::fwrite(centroids.data(), sizeof(Centroid), n, out);
+}
+
+bool QuantileSketch::read(std::FILE* in) {
+    std::size_t n = 0;
+    if (std::fread(&compression, sizeof compression, 1, in) != 1) return false;
+    if (std::fread(&total, sizeof total, 1, in) != 1
+        || std::fread(&minV, sizeof minV, 1, in) != 1
+        || std::fread(&maxV, sizeof maxV, 1, in) != 1
+        || std::fread(&n, sizeof n, 1, in) != 1)
+        throw std::runtime_error("Truncated sketch");
+    centroids.resize(n);
+    buffer.clear();
+    if (std::fread(centroids.data(), sizeof(Centroid), n, in) != n)
+        throw std::runtime_error("Truncated sketch");
+    return true;
+}
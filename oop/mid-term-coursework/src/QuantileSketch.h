@@ -0,0 +1,42 @@
+#ifndef QUANTILESKETCH_H
+#define QUANTILESKETCH_H
+#include <cstdio>                                   // For std::FILE
+#include <vector>
+
+// Mergeable streaming quantile sketch (merging t-digest, k1 scale).
+//
+// Accuracy: with compression d a centroid at quantile q spans at most
+// about 2*pi*sqrt(q*(1-q))/d of the rank range, and queries interpolate
+// between centroid centres, so the rank error is roughly half that:
+// <= 1.6% at the median and <= 0.7% at p5/p95 for the default d = 100.
+// Groups of up to ~d/2 readings (e.g. a day of hourly data) stay as
+// single points and give exact interpolated order statistics. Merging
+// sketches keeps the same bound, so partials from chunks, threads or
+// spill files can be combined freely. Memory is O(d) per sketch.
+class QuantileSketch {
+public:
+    explicit QuantileSketch(double compression = 100);
+
+    void add(double x);                        // Insert one value
+    void merge(const QuantileSketch& other);   // Fold another sketch in
+    double quantile(double q) const;           // Estimate, q in [0, 1]
+    long count() const { return total; }       // Number of values seen
+
+    // Binary (de)serialisation used by spill files
+    void write(std::FILE* out) const;
+    bool read(std::FILE* in);
+
+private:
+    struct Centroid {
+        double mean;                           // Centroid centre
+        double weight;                         // Values it represents
+    };
+    void compress() const;                     // Fold buffer into centroids
+
+    double compression;                        // Accuracy/size trade-off
+    long total = 0;                            // Values seen
+    double minV = 0, maxV = 0;                 // Exact extremes
+    mutable std::vector<Centroid> centroids;   // Sorted by mean
+    mutable std::vector<double> buffer;        // Values not yet folded in
+};
+#endif // QUANTILESKETCH_H
@@ -0,0 +1,104 @@
+#include "ResultCache.h"
+#include <cstdint>                               // For uint64_t
+#include <cstdio>                                // For rename, remove
+#include <filesystem>                            // For create_directories
+#include <stdexcept>
+#include <unistd.h>                              // For getpid
+#include "BufferedWriter.h"                      // Little-endian entry output
+#include "ByteReader.h"
+#include "CandleExporter.h"                      // Binary candle block
+
+namespace {
+const char kMagic[8] = {'W', 'T', 'C', 'A', 'C', 'H', 'E', '1'};
+const std::uint32_t kVersion = 1;
+}
+
+ResultCache::ResultCache(const std::string& dir) : dir(dir) {
+    std::error_code ec;                        // Missing directory = no hits
+    std::filesystem::create_directories(dir, ec);
+}
+
+std::string ResultCache::entryPath(const std::vector<FileIdentity>& inputs,
+                                   const std::string& query) const {
+    // FNV-1a over the input paths and the query; identities are checked
+    // inside the entry, so a changed file reuses (and replaces) the slot
+    std::uint64_t h = 14695981039346656037ull;
+    auto mix = [&](const std::string& s) {
+        for (unsigned char c : s) { h ^= c; h *= 1099511628211ull; }
+        h ^= 0xff;                             // Separator
+        h *= 1099511628211ull;
+    };
+    for (auto& in : inputs) mix(in.path);
+    mix(query);
+    char name[32];
+    std::snprintf(name, sizeof name, "%016llx.wtc", (unsigned long long)h);
+    return dir + "/" + name;
+}
+
+bool ResultCache::load(const std::vector<FileIdentity>& inputs,
+                       const std::string& query, QueryResult& result) const {
+    ByteReader in(entryPath(inputs, query));
+    if (!in.expect(kMagic, sizeof kMagic) || in.u32le() != kVersion
+        || in.u32le() != inputs.size())
+        return false;
+    for (auto& id : inputs)
+        if (FileIdentity::read(in) != id) return false; // Input changed since
+    if (in.str() != query) return false;        // Hash collision
+    QueryResult r;
+    if (!CandleExporter::readBinary(in, r.candles)) return false;
+    std::uint64_t n = in.u64le();
+    for (std::uint64_t i = 0; i < n && in.ok(); ++i) {
+        Anomaly a;
+        a.timestamp = in.str();
+        a.temperature = in.f64le();
+        a.flags = in.u32le();
+        r.anomalies.push_back(a);
+    }
+    r.filled = in.u32le() != 0;
+    if (r.filled) {
+        r.gaps.gridHours    = (long)in.u64le();
+        r.gaps.missingHours = (long)in.u64le();
+        r.gaps.gaps         = (long)in.u64le();
+        r.gaps.longestGap   = (long)in.u64le();
+        r.gaps.dropped      = (long)in.u64le();
+    }
+    r.prediction = in.f64le();
+    if (!in.ok() || in.remaining() != 0) return false;
+    result = std::move(r);
+    return true;
+}
+
+void ResultCache::store(const std::vector<FileIdentity>& inputs,
+                        const std::string& query, const QueryResult& result) const {
+    std::string path = entryPath(inputs, query);
+    // Write privately and rename, so concurrent runs never read half an entry
+    std::string tmp = path + "." + std::to_string(::getpid()) + ".tmp";
+    try {
+        {
+            BufferedWriter out(tmp);
+            out.put(kMagic, sizeof kMagic);
+            out.u32le(kVersion);
+            out.u32le((std::uint32_t)inputs.size());
+            for (auto& id : inputs) id.write(out);
+            out.str(query);
+            CandleExporter::writeBinary(out, result.candles);
+            out.u64le(result.anomalies.size());
+            for (auto& a : result.anomalies) {
+                out.str(a.timestamp);
+                out.f64le(a.temperature);
+                out.u32le(a.flags);
+            }
+            out.u32le(result.filled ? 1 : 0);
+            if (result.filled)
+                for (long v : {result.gaps.gridHours, result.gaps.missingHours,
+                               result.gaps.gaps, result.gaps.longestGap,
+                               result.gaps.dropped})
+                    out.u64le((std::uint64_t)v);
+            out.f64le(result.prediction);
+            out.flush();
+        }
+        if (std::rename(tmp.c_str(), path.c_str()) != 0) std::remove(tmp.c_str());
+    } catch (const std::runtime_error&) {
+        std::remove(tmp.c_str());              // Unwritable cache: just no entry
+    }
+}
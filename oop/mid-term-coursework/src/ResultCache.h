@@ -0,0 +1,43 @@
+#ifndef RESULTCACHE_H
+#define RESULTCACHE_H
+#include <string>
+#include <vector>
+#include "AnomalyDetector.h"                  // For Anomaly
+#include "Candlestick.h"
+#include "FileIdentity.h"                     // Input files of an entry
+#include "GapFiller.h"                        // For GapStats
+
+// Everything a run derives from the raw rows
+struct QueryResult {
+    std::vector<Candlestick> candles;          // Built (and anomaly-tagged) candles
+    std::vector<Anomaly> anomalies;            // Flagged readings, if requested
+    bool filled = false;                       // Gap statistics below set?
+    GapStats gaps;
+    double prediction = 0;                     // Predicted next candle average
+};
+
+// Persistent cache of query results, one file per entry in a directory.
+// An entry is named by a hash of the input paths and the normalised query
+// text, and stores the inputs' identities (size, mtime) and the full query
+// text; a lookup only hits if all of them still match, so editing an
+// input simply makes the next run rebuild and overwrite that entry.
+class ResultCache {
+public:
+    // Use (and create if needed) the directory `dir`
+    explicit ResultCache(const std::string& dir);
+
+    // Cached result for the inputs and query, if there is a valid one
+    bool load(const std::vector<FileIdentity>& inputs, const std::string& query,
+              QueryResult& result) const;
+
+    // Save a result; failures to write are ignored (the cache is optional)
+    void store(const std::vector<FileIdentity>& inputs, const std::string& query,
+               const QueryResult& result) const;
+
+private:
+    std::string entryPath(const std::vector<FileIdentity>& inputs,
+                          const std::string& query) const;
+
+    std::string dir;
+};
+#endif // RESULTCACHE_H
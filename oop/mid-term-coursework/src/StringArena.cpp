@@ -0,0 +1,88 @@
+#include "StringArena.h"
+#include <cstring>                               // For memcpy
+
+StringArena::StringArena(std::size_t blockSize)
+    : blockSize(blockSize) {}
+
+StringArena::StringArena(StringArena&& other) noexcept
+    : blockSize(other.blockSize),
+      blocks(std::move(other.blocks)),
+      cur(other.cur), left(other.left), curSize(other.curSize),
+      reserved(other.reserved),
+      interned(std::move(other.interned)) {
+    other.blocks.clear();                      // Source must not reuse our block
+    other.cur = nullptr;
+    other.left = other.curSize = other.reserved = 0;
+    other.interned.clear();
+}
+
+StringArena& StringArena::operator=(StringArena&& other) noexcept {
+    if (this != &other) {
+        blocks.clear();                        // Frees our own strings
+        interned.clear();
+        blockSize = other.blockSize;
+        cur = nullptr;
+        left = curSize = reserved = 0;
+        adopt(std::move(other));
+    }
+    return *this;
+}
+
+std::string_view StringArena::store(std::string_view s) {
+    if (s.size() > left) {                     // Start a new block
+        std::size_t size = s.size() > blockSize ? s.size() : blockSize;
+        blocks.emplace_back(new char[size]);
+        cur = blocks.back().get();
+        left = curSize = size;
+        reserved += size;
+    }
+    char* p = cur;
+    if (!s.empty()) std::memcpy(p, s.data(), s.size());
+    cur += s.size();
+    left -= s.size();
+    return std::string_view(p, s.size());
+}
+
+std::string_view StringArena::intern(std::string_view s) {
+    auto it = interned.find(s);
+    if (it != interned.end()) return *it;
+    std::string_view v = store(s);
+    interned.insert(v);
+    return v;
+}
+
+void StringArena::adopt(StringArena&& other) {
+    if (&other == this) return;
+    // Keep our newest block last so store() keeps filling it
+    std::unique_ptr<char[]> newest;
+    if (!blocks.empty()) {
+        newest = std::move(blocks.back());
+        blocks.pop_back();
+    }
+    for (auto& b : other.blocks) blocks.push_back(std::move(b));
+    if (newest) {
+        blocks.push_back(std::move(newest));
+    } else {                                   // We had nothing: continue theirs
+        cur = other.cur;
+        left = other.left;
+        curSize = other.curSize;
+    }
+    reserved += other.reserved;
+    interned.insert(other.interned.begin(), other.interned.end());
+    other.blocks.clear();
+    other.cur = nullptr;
+    other.left = other.curSize = other.reserved = 0;
+    other.interned.clear();
+}
+
+void StringArena::clear() {
+    interned.clear();
+    if (blocks.empty()) return;
+    if (blocks.size() > 1) {                   // Keep only the newest block
+        std::unique_ptr<char[]> newest = std::move(blocks.back());
+        blocks.clear();
+        blocks.push_back(std::move(newest));
+    }
+    cur = blocks.back().get();
+    left = reserved = curSize;
+}
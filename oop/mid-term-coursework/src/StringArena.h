@@ -0,0 +1,46 @@
+#ifndef STRINGARENA_H
+#define STRINGARENA_H
+#include <cstddef>                                  // For std::size_t
+#include <memory>                                   // For std::unique_ptr
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+// Monotonic string storage. Strings are copied into large blocks and
+// handed out as string_views that stay valid until the arena (or whoever
+// adopted its blocks) is destroyed, so loading N strings costs a handful
+// of block allocations and freeing them is one delete per block.
+class StringArena {
+public:
+    explicit StringArena(std::size_t blockSize = 1 << 20);
+    StringArena(StringArena&& other) noexcept;
+    StringArena& operator=(StringArena&& other) noexcept;
+    StringArena(const StringArena&) = delete;
+    StringArena& operator=(const StringArena&) = delete;
+
+    // Copy a string into the arena
+    std::string_view store(std::string_view s);
+
+    // Like store, but returns the same view for equal strings (for small
+    // sets of repeated values such as country codes)
+    std::string_view intern(std::string_view s);
+
+    // Take ownership of another arena's blocks; its views stay valid
+    void adopt(StringArena&& other);
+
+    // Forget all strings but keep the newest block for reuse
+    void clear();
+
+    // Bytes held in blocks
+    std::size_t capacity() const { return reserved; }
+
+private:
+    std::size_t blockSize;                     // Default block size
+    std::vector<std::unique_ptr<char[]>> blocks;
+    char* cur = nullptr;                       // Free space in the newest block
+    std::size_t left = 0;
+    std::size_t curSize = 0;                   // Size of the newest block
+    std::size_t reserved = 0;
+    std::unordered_set<std::string_view> interned;
+};
+#endif // STRINGARENA_H
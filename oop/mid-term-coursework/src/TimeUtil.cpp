@@ -0,0 +1,86 @@
+#include "TimeUtil.h"
+#include <cctype>                                // For isdigit
+#include <cstdio>                                // For snprintf
+
+// Date algorithms after H. Hinnant, "chrono-Compatible Low-Level Date Algorithms"
+long long TimeUtil::daysFromCivil(int y, int m, int d) {
+    y -= m <= 2;
+    long long era = (y >= 0 ? y : y - 399) / 400;
+    long long yoe = y - era * 400;                              // [0, 399]
+    long long doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1; // [0, 365]
+    long long doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;      // [0, 146096]
+    return era * 146097 + doe - 719468;
+}
+
+void TimeUtil::civilFromDays(long long z, int& y, int& m, int& d) {
+    z += 719468;
+    long long era = (z >= 0 ? z : z - 146096) / 146097;
+    long long doe = z - era * 146097;
+    long long yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    long long doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    long long mp = (5 * doy + 2) / 153;
+    d = (int)(doy - (153 * mp + 2) / 5 + 1);
+    m = (int)(mp < 10 ? mp + 3 : mp - 9);
+    y = (int)(yoe + era * 400 + (m <= 2));
+}
+
+bool TimeUtil::parse(std::string_view ts, long long& secs) {
+    // Read `n` digits at `pos` into `out`
+    auto num = [&](std::size_t pos, int n, int& out) {
+        if (pos + n > ts.size()) return false;
+        out = 0;
+        for (int i = 0; i < n; ++i) {
+            if (!std::isdigit((unsigned char)ts[pos + i])) return false;
+            out = out * 10 + (ts[pos + i] - '0');
+        }
+        return true;
+    };
+    int y, mo, d, h = 0, mi = 0, s = 0;
+    if (ts.size() < 10) return false;         // YYYY-MM-DD at least
+    if (!num(0, 4, y) || ts[4] != '-' || !num(5, 2, mo) || ts[7] != '-'
+        || !num(8, 2, d) || mo < 1 || mo > 12 || d < 1 || d > 31)
+        return false;
+    if (ts.size() >= 13 && num(11, 2, h) && ts.size() >= 16 && ts[13] == ':'
+        && num(14, 2, mi) && ts.size() >= 19 && ts[16] == ':')
+        num(17, 2, s);
+    secs = ((daysFromCivil(y, mo, d) * 24 + h) * 60 + mi) * 60 + s;
+    return true;
+}
+
+std::string TimeUtil::format(long long secs) {
+    char buf[32];
+    return std::string(buf, format(secs, buf));
+}
+
+std::size_t TimeUtil::format(long long secs, char* out) {
+    long long days = secs >= 0 ? secs / 86400 : -((-secs + 86399) / 86400);
+    long long rem = secs - days * 86400;      // [0, 86399]
+    int y, m, d;
+    civilFromDays(days, y, m, d);
+    int n = std::snprintf(out, 21, "%04d-%02d-%02dT%02d:%02d:%02dZ", y, m, d,
+                          (int)(rem / 3600), (int)(rem / 60 % 60), (int)(rem % 60));
+    return n < 21 ? (std::size_t)n : 20;      // Years beyond 9999 are cut
+}
+
+std::size_t TimeUtil::formatLocal(long long utc, int offset, char* out) {
+    // Write `v` as `n` digits (snprintf would dominate a per-row loop)
+    auto digits = [](char* p, int v, int n) {
+        for (int i = n - 1; i >= 0; --i, v /= 10) p[i] = (char)('0' + v % 10);
+    };
+    long long secs = utc + offset;
+    long long days = secs >= 0 ? secs / 86400 : -((-secs + 86399) / 86400);
+    int rem = (int)(secs - days * 86400);      // [0, 86399]
+    int y, m, d;
+    civilFromDays(days, y, m, d);
+    digits(out, y, 4);       out[4] = '-';
+    digits(out + 5, m, 2);   out[7] = '-';
+    digits(out + 8, d, 2);   out[10] = 'T';
+    digits(out + 11, rem / 3600, 2);     out[13] = ':';
+    digits(out + 14, rem / 60 % 60, 2);  out[16] = ':';
+    digits(out + 17, rem % 60, 2);
+    out[19] = offset < 0 ? '-' : '+';
+    int a = offset < 0 ? -offset : offset;
+    digits(out + 20, a / 3600, 2);       out[22] = ':';
+    digits(out + 23, a / 60 % 60, 2);    // Sub-minute offsets (LMT) are cut
+    return 25;
+}
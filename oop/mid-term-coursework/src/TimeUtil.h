@@ -0,0 +1,30 @@
+#ifndef TIMEUTIL_H
+#define TIMEUTIL_H
+#include <string>
+#include <string_view>
+
+// Calendar helpers for ISO-8601 timestamps such as 2015-01-01T00:00:00Z
+class TimeUtil {
+public:
+    // Days since 1970-01-01 for a proleptic Gregorian date
+    static long long daysFromCivil(int y, int m, int d);
+
+    // Inverse of daysFromCivil
+    static void civilFromDays(long long days, int& y, int& m, int& d);
+
+    // Parse YYYY-MM-DD[THH[:MM[:SS]]] (trailing zone text ignored) into
+    // seconds since the epoch; false if the text is not a timestamp
+    static bool parse(std::string_view ts, long long& secs);
+
+    // Format seconds since the epoch as YYYY-MM-DDTHH:MM:SSZ
+    static std::string format(long long secs);
+
+    // Same, into a caller buffer of at least 21 bytes; returns the length
+    static std::size_t format(long long secs, char* out);
+
+    // Format a UTC instant as local time with its offset in seconds east
+    // of UTC (YYYY-MM-DDTHH:MM:SS+HH:MM) into a buffer of at least 25
+    // bytes; returns the length. Years must lie in 0000-9999.
+    static std::size_t formatLocal(long long utc, int offset, char* out);
+};
+#endif // TIMEUTIL_H
@@ -0,0 +1,226 @@
+#include "TimeZone.h"
+#include <algorithm>                              // For std::upper_bound, std::sort
+#include <cctype>                                 // For std::isalpha
+#include <cstdint>                                // For int32_t
+#include <cstdlib>                                // For std::getenv
+#include <fstream>                                // For reading TZif files
+#include <iterator>                               // For istreambuf_iterator
+#include <stdexcept>                              // For exceptions
+#include <string_view>
+#include <utility>                                // For std::pair
+#include "TimeUtil.h"                             // Calendar helpers
+
+namespace {
+
+const int kLastRuleYear = 2100;                   // Footer rules are expanded up to here
+
+// Big-endian signed integer of 4 or 8 bytes
+long long readBE(const unsigned char* p, int n) {
+    unsigned long long v = 0;
+    for (int i = 0; i < n; ++i) v = v << 8 | p[i];
+    return n == 4 ? (long long)(int32_t)(uint32_t)v : (long long)v;
+}
+
+// One end of a daylight-saving period in a POSIX TZ rule
+struct RuleDate {
+    char kind = 'M';                              // 'M' (Mm.w.d), 'J' (Jn) or 'N' (n)
+    int month = 0, week = 0, day = 0;
+    long long time = 7200;                        // Local time of day, default 02:00
+};
+
+// Cursor over a POSIX TZ string such as AEST-10AEDT,M10.1.0,M4.1.0/3
+struct RuleParser {
+    std::string_view s;
+    std::size_t pos = 0;
+
+    bool at(char c) const { return pos < s.size() && s[pos] == c; }
+    bool digit() const { return pos < s.size() && s[pos] >= '0' && s[pos] <= '9'; }
+
+    int number() {
+        int v = 0;
+        while (digit()) v = v * 10 + (s[pos++] - '0');
+        return v;
+    }
+
+    // Zone abbreviation: letters, or anything between < and >
+    bool name() {
+        std::size_t start = pos;
+        if (at('<')) {
+            while (pos < s.size() && s[pos] != '>') ++pos;
+            if (!at('>')) return false;
+            ++pos;
+            return true;
+        }
+        while (pos < s.size() && std::isalpha((unsigned char)s[pos])) ++pos;
+        return pos > start;
+    }
+
+    // [+-]h[h][:mm[:ss]] as seconds
+    bool hms(long long& secs) {
+        int sign = 1;
+        if (at('+') || at('-')) sign = s[pos++] == '-' ? -1 : 1;
+        if (!digit()) return false;
+        secs = number() * 3600LL;
+        if (at(':')) { ++pos; secs += number() * 60LL; }
+        if (at(':')) { ++pos; secs += number(); }
+        secs *= sign;
+        return true;
+    }
+
+    bool date(RuleDate& r) {
+        if (at('M')) {
+            ++pos;
+            r.month = number();
+            if (!at('.')) return false;
+            ++pos;
+            r.week = number();
+            if (!at('.')) return false;
+            ++pos;
+            r.day = number();
+        } else if (at('J')) {
+            ++pos;
+            r.kind = 'J';
+            r.day = number();
+        } else if (digit()) {
+            r.kind = 'N';
+            r.day = number();
+        } else {
+            return false;
+        }
+        if (at('/')) { ++pos; return hms(r.time); }
+        return true;
+    }
+};
+
+// Day number (days since 1970-01-01) on which a rule date falls in year y
+long long ruleDay(const RuleDate& r, int y) {
+    long long jan1 = TimeUtil::daysFromCivil(y, 1, 1);
+    bool leap = (y % 4 == 0 && y % 100 != 0) || y % 400 == 0;
+    if (r.kind == 'J') return jan1 + r.day - 1 + (leap && r.day >= 60);
+    if (r.kind == 'N') return jan1 + r.day;
+    long long first = TimeUtil::daysFromCivil(y, r.month, 1);
+    long long next = r.month == 12 ? TimeUtil::daysFromCivil(y + 1, 1, 1)
+                                   : TimeUtil::daysFromCivil(y, r.month + 1, 1);
+    int dow = (int)(((first + 4) % 7 + 7) % 7);   // 1970-01-01 was a Thursday
+    long long day = first + (r.day - dow + 7) % 7 + (r.week - 1) * 7LL;
+    while (day >= next) day -= 7;                 // Week 5 means "last"
+    return day;
+}
+
+// Append the transitions a POSIX TZ rule produces after `after`
+void expandRule(std::string_view tz, long long after,
+                std::vector<long long>& at, std::vector<int>& offsets) {
+    RuleParser p{tz};
+    long long stdOff, dstOff;
+    if (!p.name() || !p.hms(stdOff) || !p.name()) return; // No daylight saving
+    stdOff = -stdOff;                             // POSIX offsets count west
+    dstOff = stdOff + 3600;
+    if (!p.at(',')) {
+        if (!p.hms(dstOff)) return;
+        dstOff = -dstOff;
+    }
+    RuleDate start, end;
+    if (!p.at(',')) return;
+    ++p.pos;
+    if (!p.date(start) || !p.at(',')) return;
+    ++p.pos;
+    if (!p.date(end)) return;
+
+    int y, m, d;
+    TimeUtil::civilFromDays(std::max(after, 0LL) / 86400, y, m, d);
+    std::vector<std::pair<long long, int>> rules;
+    for (; y <= kLastRuleYear; ++y) {
+        // Each rule time is given in the local time in force before it
+        rules.push_back({ruleDay(start, y) * 86400 + start.time - stdOff, (int)dstOff});
+        rules.push_back({ruleDay(end, y) * 86400 + end.time - dstOff, (int)stdOff});
+    }
+    std::sort(rules.begin(), rules.end());        // Southern zones end before they start
+    for (auto& [t, off] : rules) {
+        if (t <= after || off == offsets.back()) continue;
+        at.push_back(t);
+        offsets.push_back(off);
+    }
+}
+
+} // namespace
+
+TimeZone TimeZone::load(const std::string& name) {
+    const char* dir = std::getenv("TZDIR");
+    std::string path = !name.empty() && name[0] == '/' ? name
+        : std::string(dir && *dir ? dir : "/usr/share/zoneinfo") + "/" + name;
+    std::ifstream in(path, std::ios::binary);
+    if (!in) throw std::runtime_error("Unknown time zone " + name);
+    std::string file((std::istreambuf_iterator<char>(in)),
+                     std::istreambuf_iterator<char>());
+    auto bytes = reinterpret_cast<const unsigned char*>(file.data());
+
+    // RFC 8536 layout: 44-byte header, then the data block. Version 2+
+    // files repeat both with 64-bit times, followed by a POSIX rule footer.
+    std::size_t pos = 0;
+    long long isut, isstd, leaps, times, types, chars;
+    auto header = [&]() {
+        if (file.size() < pos + 44 || file.compare(pos, 4, "TZif") != 0)
+            throw std::runtime_error("Bad time zone file " + path);
+        const unsigned char* c = bytes + pos + 20;
+        isut  = readBE(c, 4);      isstd = readBE(c + 4, 4);
+        leaps = readBE(c + 8, 4);  times = readBE(c + 12, 4);
+        types = readBE(c + 16, 4); chars = readBE(c + 20, 4);
+        pos += 44;
+    };
+    auto blockSize = [&](int timeSize) {
+        return times * (timeSize + 1) + types * 6 + chars
+             + leaps * (timeSize + 4) + isstd + isut;
+    };
+    header();
+    int timeSize = 4;
+    if (file[4] >= '2') {                         // Skip the 32-bit block
+        pos += blockSize(4);
+        header();
+        timeSize = 8;
+    }
+    if (types < 1 || file.size() < pos + blockSize(timeSize))
+        throw std::runtime_error("Bad time zone file " + path);
+
+    const unsigned char* instants = bytes + pos;
+    const unsigned char* index = instants + times * timeSize;
+    const unsigned char* info = index + times;    // 6 bytes per local time type
+    auto utoff = [&](int type) { return (int)readBE(info + 6 * type, 4); };
+
+    TimeZone zone;
+    zone.zoneName = name;
+    zone.offsets = {utoff(0)};                    // Type 0 applies before the first transition
+    for (long long i = 0; i < times; ++i) {
+        int type = index[i];
+        if (type >= types) throw std::runtime_error("Bad time zone file " + path);
+        if (utoff(type) == zone.offsets.back()) continue; // Name or DST flag change only
+        zone.at.push_back(readBE(instants + i * timeSize, timeSize));
+        zone.offsets.push_back(utoff(type));
+    }
+
+    pos += blockSize(timeSize);
+    if (timeSize == 8 && pos < file.size() && file[pos] == '\n') {
+        std::size_t endRule = file.find('\n', pos + 1);
+        if (endRule != std::string::npos)
+            expandRule(std::string_view(file).substr(pos + 1, endRule - pos - 1),
+                       zone.at.empty() ? 0 : zone.at.back(), zone.at, zone.offsets);
+    }
+    return zone;
+}
+
+int TimeZone::offsetAt(long long utc) const {
+    return offsets[std::upper_bound(at.begin(), at.end(), utc) - at.begin()];
+}
+
+void TimeZone::localise(WeatherDataset& data) const {
+    std::size_t i = 0;                            // Table interval of the previous row
+    char buf[32];
+    for (auto& r : data.records) {
+        long long t;
+        if (!TimeUtil::parse(r.timestamp, t)) continue;
+        // Rows are time-sorted, so the previous interval usually still holds
+        if ((i > 0 && t < at[i - 1]) || (i < at.size() && t >= at[i]))
+            i = std::upper_bound(at.begin(), at.end(), t) - at.begin();
+        r.timestamp = data.strings.store(
+            std::string_view(buf, TimeUtil::formatLocal(t, offsets[i], buf)));
+    }
+}
@@ -0,0 +1,35 @@
+#ifndef TIMEZONE_H
+#define TIMEZONE_H
+#include <string>
+#include <vector>
+#include "WeatherLoader.h"                    // For WeatherDataset
+
+// UTC offsets of an IANA time zone as a compact transition table:
+// sorted transition instants plus the offset in force after each one.
+// The table is read once from the system tzdata (TZif files under
+// $TZDIR or /usr/share/zoneinfo); the zone's POSIX rule is expanded
+// up to 2100 for files that stop listing transitions early.
+class TimeZone {
+public:
+    // UTC (no transitions)
+    TimeZone() = default;
+
+    // Load a zone such as "Australia/Sydney"; throws if it cannot be read
+    static TimeZone load(const std::string& name);
+
+    const std::string& name() const { return zoneName; }
+
+    // Seconds east of UTC at a UTC instant (one binary search)
+    int offsetAt(long long utc) const;
+
+    // Rewrite every timestamp as local time with its offset, e.g.
+    // 2015-01-01T11:00:00+11:00, so date prefixes name the local day.
+    // Views go into the dataset's arena; unparsable timestamps are kept.
+    void localise(WeatherDataset& data) const;
+
+private:
+    std::string zoneName = "UTC";
+    std::vector<long long> at;                 // Transition instants (UTC seconds)
+    std::vector<int> offsets{0};               // offsets[i] holds from at[i-1] to at[i]
+};
+#endif // TIMEZONE_H
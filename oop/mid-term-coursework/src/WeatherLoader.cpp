@@ -1,46 +1,96 @@
 #include "WeatherLoader.h"                    // Include loader header
-#include <fstream>                                // For file I/O
-#include <sstream>                                // For string stream
+#include <limits>                                 // For quiet_NaN
 #include <stdexcept>                              // For exceptions
+#include "CsvReader.h"                            // Shared CSV reader (oop/common)
 
-std::vector<WeatherRecord> WeatherLoader::loadCSV(
+void WeatherDataset::append(WeatherDataset&& other) {
+    if (records.empty()) records = std::move(other.records);
+    else records.insert(records.end(), other.records.begin(), other.records.end());
+    other.records.clear();
+    strings.adopt(std::move(other.strings));  // Views stay valid
+}
+
+WeatherDataset WeatherLoader::loadCSV(
     const std::string& filename,
     const std::string& country) {
-    std::ifstream infile(filename);           // Open file
-    if (!infile) throw std::runtime_error("Cannot open " + filename); // Error if fail
-
-    std::string header;                       // To read header line
-    std::getline(infile, header);            // Read header
-    std::stringstream hs(header);            // Stream for splitting
-    std::vector<std::string> cols;           // Vector for column names
-    std::string col;
-    while (std::getline(hs, col, ','))       // Split by comma
-        cols.push_back(col);                 // Store each header
-
-    int idxTs = -1, idxTemp = -1;            // Indices for timestamp & temp
-    for (int i = 0; i < (int)cols.size(); ++i) {
-        if (cols[i] == "utc_timestamp") idxTs = i;       // Find timestamp col
-        if (cols[i] == country + "_temperature") idxTemp = i; // Find temp col
+    WeatherDataset data;                      // Output dataset
+    streamCSV(filename, country, 1 << 16,
+              [&data](WeatherDataset& window) {
+                  data.append(std::move(window)); // Take records and strings
+              });
+    return data;                              // Return records
+}
+
+void WeatherLoader::streamCSV(
+    const std::string& filename,
+    const std::string& country,
+    std::size_t windowRows,
+    const WindowHandler& onWindow) {
+    csv::Reader in(filename);                // Open file (throws if missing)
+    if (windowRows == 0) windowRows = 1;      // Always make progress
+
+    // Timestamp and temperature columns mapped straight onto the record
+    auto columns = csv::mapping(
+        csv::column("utc_timestamp", &WeatherRecord::timestamp),
+        csv::column(country + "_temperature", &WeatherRecord::temperature));
+    columns.bind(in.readHeader());           // Throws if a column is missing
+
+    WeatherDataset window;                   // Current window of records
+    window.records.reserve(windowRows);
+    std::string_view code = window.strings.intern(country);
+    WeatherRecord r{};
+    while (in.next()) {                      // Read each data line
+        if (!columns.read(in, r)) continue;  // Skip short rows and parse errors
+        r.timestamp = window.strings.store(r.timestamp); // Copy out of the read buffer
+        r.country = code;
+        window.records.push_back(r);
+        if (window.records.size() >= windowRows) { // Window full: hand it over
+            onWindow(window);
+            window.records.clear();
+            window.strings.clear();          // Reuse the block if still ours
+            code = window.strings.intern(country);
+        }
+    }
+    if (!window.records.empty()) onWindow(window); // Flush the final window
+}
+
+WeatherTable WeatherLoader::loadTable(
+    const std::string& filename,
+    const std::vector<std::string>& countries) {
+    csv::Reader in(filename);                // Open file (throws if missing)
+    csv::Header header = in.readHeader();
+    if (header.rows.empty()) throw std::runtime_error("Missing header fields");
+    const std::vector<std::string>& cols = header.rows[0];
+
+    const std::string suffix = "_temperature";
+    WeatherTable table;
+    int idxTs = header.find("utc_timestamp");
+    std::vector<int> idx;                     // CSV column per table column
+    for (int i = 0; countries.empty() && i < (int)cols.size(); ++i)
+        if (cols[i].size() > suffix.size()
+            && cols[i].compare(cols[i].size() - suffix.size(), suffix.size(), suffix) == 0) {
+            table.countries.push_back(cols[i].substr(0, cols[i].size() - suffix.size()));
+            idx.push_back(i);                 // Every temperature column
+        }
+    for (auto& c : countries) {               // Requested columns, in order
+        int found = header.find(c + suffix);
+        if (found < 0) throw std::runtime_error("Missing column " + c + suffix);
+        table.countries.push_back(c);
+        idx.push_back(found);
     }
-    // Validate indices
-    if (idxTs < 0 || idxTemp < 0)
+    if (idxTs < 0 || idx.empty())
         throw std::runtime_error("Missing header fields");
+    table.columns.resize(idx.size());
 
-    std::vector<WeatherRecord> data;         // Output vector
-    std::string line;
-    while (std::getline(infile, line)) {    // Read each data line
-        std::stringstream ss(line);          // Split line
-        std::vector<std::string> row;
-        std::string cell;
-        while (std::getline(ss, cell, ',')) // Split by comma
-            row.push_back(cell);            // Store cell
-        if ((int)row.size() <= idxTemp) continue; // Skip invalid rows
-        try {
-            double temp = std::stod(row[idxTemp]);   // Convert to double
-            data.push_back({row[idxTs], country, temp}); // Add record
-        } catch (...) {
-            // Skip parse errors
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    while (in.next()) {
+        if ((int)in.size() <= idxTs) continue; // No timestamp
+        table.timestamps.push_back(table.strings.store(in[idxTs]));
+        for (std::size_t c = 0; c < idx.size(); ++c) {
+            double v;                         // Missing or unparsable -> NaN
+            bool ok = idx[c] < (int)in.size() && csv::parse(in[idx[c]], v);
+            table.columns[c].push_back(ok ? (float)v : nan);
         }
     }
-    return data;                              // Return records
+    return table;
 }
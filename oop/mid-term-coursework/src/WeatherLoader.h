@@ -1,20 +1,62 @@
 #ifndef WEATHERLOADER_H
 #define WEATHERLOADER_H
+#include <cstddef>                                  // For std::size_t
+#include <functional>                               // For std::function
 #include <string>                                   // For std::string
+#include <string_view>                              // For std::string_view
 #include <vector>                                   // For std::vector
+#include "StringArena.h"                            // Owns record strings
 
-// Struct to hold single weather data record
+// Struct to hold single weather data record. The strings live in the
+// StringArena of the dataset (or table) the record came from.
 struct WeatherRecord {
-    std::string timestamp;                     // UTC timestamp string
-    std::string country;                       // Country code
+    std::string_view timestamp;                // UTC timestamp string
+    std::string_view country;                  // Country code
     double temperature;                        // Temperature value
 };
 
+// Records together with the arena that owns their strings; move-only
+struct WeatherDataset {
+    std::vector<WeatherRecord> records;        // Parsed rows
+    StringArena strings;                       // Timestamp / country storage
+
+    // Move another dataset's records to the end and adopt its strings
+    void append(WeatherDataset&& other);
+};
+
+// Several country columns side by side; missing cells are NaN
+struct WeatherTable {
+    std::vector<std::string_view> timestamps;  // One per row (in `strings`)
+    std::vector<std::string> countries;        // Country code per column
+    std::vector<std::vector<float>> columns;   // Contiguous column per country
+    StringArena strings;                       // Timestamp storage
+};
+
 class WeatherLoader {
 public:
+    // Callback receiving one window of parsed records; may consume them
+    // (e.g. append them to another dataset)
+    using WindowHandler = std::function<void(WeatherDataset&)>;
+
     // Load CSV file and extract only the specified country column
-    static std::vector<WeatherRecord> loadCSV(
+    static WeatherDataset loadCSV(
         const std::string& filename,           // Path to CSV file
         const std::string& country);           // Country code for column
+
+    // Load several country columns at once; an empty list loads every
+    // <CC>_temperature column in the file
+    static WeatherTable loadTable(
+        const std::string& filename,           // Path to CSV file
+        const std::vector<std::string>& countries); // Country codes
+
+    // Stream the CSV in windows of at most windowRows records, so memory
+    // use is bounded by the window instead of the file size. The window's
+    // arena is reused, so views are only valid inside the callback unless
+    // the handler takes the dataset over.
+    static void streamCSV(
+        const std::string& filename,           // Path to CSV file
+        const std::string& country,            // Country code for column
+        std::size_t windowRows,                // Records per window
+        const WindowHandler& onWindow);        // Called once per window
 };
 #endif // WEATHERLOADER_H
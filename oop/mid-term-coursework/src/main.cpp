@@ -1,29 +1,116 @@
+#include <cctype>                               // For std::toupper
+#include <iomanip>                              // For std::setw
 #include <iostream>                             // For std::cout, std::cerr
+#include <sstream>                              // For splitting lists
 #include <string>                               // For std::string
 #include <vector>                               // For std::vector
 #include "WeatherLoader.h"                    // CSV loader
-#include "DataFilter.h"                       // Filters
+#include "MultiFileLoader.h"                  // Multi-file loader
+#include "FilterExpression.h"                 // Compiled filters
 #include "CandlestickBuilder.h"               // Builder
+#include "BoundedAggregator.h"                // Bounded-memory builder
+#include "GapFiller.h"                        // Hourly resampling
+#include "TimeZone.h"                         // Local-time bucketing
+#include "Climatology.h"                      // Departure from normal
+#include "ResultCache.h"                      // Persistent result cache
+#include "AnomalyDetector.h"                  // Anomaly detection
+#include "IndicatorEngine.h"                  // Technical indicators
+#include "CountryComparison.h"                // Cross-country statistics
 #include "ASCIIPlotter.h"                     // Plotter
+#include "CandleExporter.h"                   // CSV / NDJSON / binary export
 #include "Predictor.h"                        // Predictor
 
+// Parse a byte size such as 512M, 2G or 65536 (suffixes are powers of 1024)
+static std::size_t parseByteSize(const std::string& s) {
+    std::size_t pos = 0;
+    double value = std::stod(s, &pos);        // Numeric part
+    std::size_t scale = 1;
+    if (pos < s.size()) {
+        switch (std::toupper(static_cast<unsigned char>(s[pos]))) {
+        case 'K': scale = 1ull << 10; break;
+        case 'M': scale = 1ull << 20; break;
+        case 'G': scale = 1ull << 30; break;
+        default: throw std::invalid_argument("Bad size suffix: " + s);
+        }
+    }
+    return static_cast<std::size_t>(value * scale);
+}
+
+// Count anomalies per candle (both lists are sorted by time)
+static void tagCandles(std::vector<Candlestick>& candles,
+                       const std::vector<Anomaly>& anomalies,
+                       Period period) {
+    std::size_t len = CandlestickBuilder::keyLength(period);
+    std::size_t c = 0;
+    for (auto& a : anomalies) {
+        std::string_view key = std::string_view(a.timestamp).substr(0, len);
+        while (c < candles.size() && candles[c].period < key) ++c;
+        if (c < candles.size() && candles[c].period == key)
+            ++candles[c].anomalies;
+    }
+}
+
+// Load the country columns of every file, merged by timestamp like the
+// single-country loader, keeping rows in [from, to]
+static WeatherTable loadTables(const std::vector<std::string>& files,
+                               const std::vector<std::string>& countries,
+                               const std::string& from,
+                               const std::string& to) {
+    WeatherTable t = MultiFileLoader::loadTable(files, countries);
+    std::size_t kept = 0;
+    for (std::size_t r = 0; r < t.timestamps.size(); ++r) {
+        std::string_view d = t.timestamps[r].substr(0, 10);
+        if (d < from || d > to) continue;     // Same rule as byDateRange
+        t.timestamps[kept] = t.timestamps[r];
+        for (auto& col : t.columns) col[kept] = col[r];
+        ++kept;
+    }
+    t.timestamps.resize(kept);
+    for (auto& col : t.columns) col.resize(kept);
+    return t;
+}
+
 int main(int argc, char* argv[]) {
     // Check for required arguments
     if (argc < 3) {
         std::cerr << "Usage: " << argv[0]
-                  << " <csv-file> <COUNTRY_CODE> [--from YYYY-MM-DD]"
-                     " [--to YYYY-MM-DD] [--minT X] [--maxT Y]"
-                     " [--period year|month|day] [--plot] [--predict]\n";
+                  << " <csv-file[,csv-file|glob...]> <COUNTRY_CODE> [--from YYYY-MM-DD]"
+                     " [--to YYYY-MM-DD] [--minT X] [--maxT Y] [--where EXPR]"
+                     " [--period year|month|day] [--mem-limit SIZE]"
+                     " [--fill linear|previous|seasonal] [--tz ZONE]"
+                     " [--departure deg|z] [--cache DIR]"
+                     " [--quantiles] [--anomalies] [--window N]"
+                     " [--indicators W1,W2,...] [--correlate]"
+                     " [--compare all|CC,CC,...] [--lag N] [--diff CC]"
+                     " [--export FILE] [--format csv|ndjson|bin]"
+                     " [--plot] [--predict]\n";
         return 1;                              // Exit if missing
     }
 
-    std::string file    = argv[1];            // CSV file path
+    auto files          = MultiFileLoader::expandInputs(argv[1]); // CSV paths
     std::string country = argv[2];            // Country code to load
     std::string from    = "0000-00-00";      // Date filter start
     std::string to      = "9999-12-31";      // Date filter end
     double minT         = -1e9;               // Min temperature filter
     double maxT         = 1e9;                // Max temperature filter
+    std::string where;                        // Filter expression
     Period period       = Period::MONTH;      // Default period grouping
+    std::size_t memLimit = 0;                 // Memory budget (0 = unbounded)
+    bool doFill         = false;              // Resample to an hourly grid
+    FillPolicy fill     = FillPolicy::LINEAR; // Gap fill method
+    std::string tzName;                       // IANA zone for local time (empty = UTC)
+    std::string departure;                    // deg / z = departure from normal
+    std::string cacheDir;                     // Result cache directory (empty = off)
+    bool doQuantiles    = false;              // Quantile fields flag
+    bool doAnomalies    = false;              // Anomaly detection flag
+    AnomalyDetector::Config detector;         // Detector settings
+    std::vector<int> indicatorWindows;        // Indicator window lengths
+    bool doCorrelate    = false;              // Correlation matrix flag
+    std::vector<std::string> compareWith;     // Countries to compare (empty = all)
+    int maxLag          = 0;                  // Cross-correlation lag range
+    std::string diffWith;                     // Difference candles vs. country
+    std::string exportPath;                   // Export destination ("-" = stdout)
+    ExportFormat exportFormat = ExportFormat::CSV; // Export encoding
     bool doPlot         = false;              // Plot flag
     bool doPredict      = false;              // Predict flag
 
@@ -34,31 +121,219 @@ int main(int argc, char* argv[]) {
         else if (a == "--to"   && i + 1 < argc) to   = argv[++i];
         else if (a == "--minT" && i + 1 < argc) minT = std::stod(argv[++i]);
         else if (a == "--maxT" && i + 1 < argc) maxT = std::stod(argv[++i]);
+        else if (a == "--where" && i + 1 < argc) where = argv[++i];
         else if (a == "--period" && i + 1 < argc) {
             std::string p = argv[++i];
             if      (p == "year")  period = Period::YEAR;
             else if (p == "month") period = Period::MONTH;
             else if (p == "day")   period = Period::DAY;
-        } else if (a == "--plot")    doPlot    = true; // Enable plot
+        } else if (a == "--fill" && i + 1 < argc) {
+            std::string f = argv[++i];
+            doFill = true;
+            if      (f == "linear")   fill = FillPolicy::LINEAR;
+            else if (f == "previous") fill = FillPolicy::PREVIOUS;
+            else if (f == "seasonal") fill = FillPolicy::SEASONAL;
+            else doFill = false;
+        } else if (a == "--tz" && i + 1 < argc) tzName = argv[++i];
+        else if (a == "--cache" && i + 1 < argc) cacheDir = argv[++i];
+        else if (a == "--departure" && i + 1 < argc) {
+            departure = argv[++i];
+            if (departure != "deg" && departure != "z") departure.clear();
+        }
+        else if (a == "--mem-limit" && i + 1 < argc)
+            memLimit = parseByteSize(argv[++i]); // Enable bounded mode
+        else if (a == "--quantiles") doQuantiles = true; // p5/median/p95
+        else if (a == "--anomalies") doAnomalies = true; // Flag outliers
+        else if (a == "--window" && i + 1 < argc)
+            detector.window = std::stoul(argv[++i]); // Detector window
+        else if (a == "--indicators" && i + 1 < argc) {
+            std::stringstream ws(argv[++i]);  // Comma-separated windows
+            std::string w;
+            while (std::getline(ws, w, ','))
+                indicatorWindows.push_back(std::stoi(w));
+        } else if (a == "--correlate") doCorrelate = true; // Pearson matrix
+        else if (a == "--compare" && i + 1 < argc) {
+            std::stringstream cs(argv[++i]);  // Comma-separated codes
+            std::string c;
+            while (std::getline(cs, c, ','))
+                if (c != "all") compareWith.push_back(c);
+        } else if (a == "--lag" && i + 1 < argc) maxLag = std::stoi(argv[++i]);
+        else if (a == "--diff" && i + 1 < argc) diffWith = argv[++i];
+        else if (a == "--export" && i + 1 < argc) exportPath = argv[++i];
+        else if (a == "--format" && i + 1 < argc)
+            exportFormat = CandleExporter::formatFromName(argv[++i]);
+        else if (a == "--plot")    doPlot    = true; // Enable plot
         else if (a == "--predict") doPredict = true; // Enable prediction
     }
 
-    // Load data for specified country
-    auto data = WeatherLoader::loadCSV(file, country);
-    // Apply date and temperature filters
-    data = DataFilter::byDateRange(data, from, to);
-    data = DataFilter::byTempRange(data, minT, maxT);
-    // Build candlestick data
-    auto candles = CandlestickBuilder::build(data, period);
+    if (doCorrelate || maxLag > 0) {          // Cross-country analysis
+        std::vector<std::string> cols = compareWith;
+        bool listed = false;
+        for (auto& c : cols) listed = listed || c == country;
+        if (!cols.empty() && !listed) cols.insert(cols.begin(), country);
+        WeatherTable table = loadTables(files, cols, from, to);
+        if (doCorrelate)
+            CountryComparison::printMatrix(table,
+                CountryComparison::pearsonMatrix(table));
+        if (maxLag > 0) {                      // Lag table: country vs. others
+            std::size_t ref = 0;
+            for (std::size_t c = 0; c < table.countries.size(); ++c)
+                if (table.countries[c] == country) ref = c;
+            std::vector<std::vector<double>> lagged;
+            for (auto& col : table.columns)
+                lagged.push_back(CountryComparison::crossCorrelation(
+                    table.columns[ref], col, maxLag));
+            std::cout << country << " vs    lag";
+            for (auto& c : table.countries) std::cout << std::setw(8) << c;
+            std::cout << '\n' << std::fixed << std::setprecision(3);
+            for (int l = -maxLag; l <= maxLag; ++l) {
+                std::cout << std::setw(10) << l;
+                for (auto& series : lagged)
+                    std::cout << std::setw(8) << series[l + maxLag];
+                std::cout << '\n';
+            }
+            std::cout.unsetf(std::ios::floatfield);
+            std::cout << std::setprecision(6);
+        }
+    }
+
+    // Every row filter compiled into one predicate, applied in one pass
+    FilterExpression filter;
+    try {
+        if (!where.empty()) filter = FilterExpression::parse(where);
+    } catch (const std::runtime_error& e) {
+        std::cerr << e.what() << '\n';          // Report, don't abort
+        return 1;
+    }
+    filter.restrictDates(from, to);
+    filter.restrictTemp(minT, maxT);
+    FilterExpression inDates;                 // Date range only
+    inDates.restrictDates(from, to);
+    if (!departure.empty() && !diffWith.empty()) {
+        std::cerr << "--departure cannot be combined with --diff\n";
+        return 1;
+    }
+    if (memLimit > 0 && (!diffWith.empty() || doFill)) {
+        std::cerr << "--diff and --fill are not supported with --mem-limit\n";
+        return 1;
+    }
+
+    // A cache entry is keyed by the input files and every option that
+    // changes the result, in a fixed order with canonical values. Only
+    // whether --mem-limit is set counts (merged sketches), not its size
+    QueryResult result;
+    std::vector<FileIdentity> inputs;
+    std::string query;
+    bool cached = false;
+    if (!cacheDir.empty()) {
+        const char* periodNames[] = {"year", "month", "day"};
+        const char* fillNames[] = {"linear", "previous", "seasonal"};
+        for (auto& f : files) inputs.push_back(FileIdentity::of(f));
+        query = "country=" + country
+              + "\nfilter=" + filter.canonical()   // --where, dates, temps
+              + "\ndates=" + inDates.canonical()   // Anomaly report range
+              + "\nperiod=" + periodNames[(int)period]
+              + "\nfill=" + (doFill ? fillNames[(int)fill] : "")
+              + "\ntz=" + tzName + "\ndeparture=" + departure
+              + "\ndiff=" + diffWith
+              + "\nquantiles=" + (doQuantiles ? "1" : "0")
+              + "\nanomalies=" + (doAnomalies ? std::to_string(detector.window) : "")
+              + "\nbounded=" + (memLimit > 0 ? "1" : "0");
+        cached = ResultCache(cacheDir).load(inputs, query, result);
+    }
+
+    if (!cached) {
+        // With --tz, timestamps are rewritten to local time right after
+        // loading (and gap filling), so filters, candles and anomalies see
+        // local dates
+        TimeZone zone = tzName.empty() ? TimeZone() : TimeZone::load(tzName);
+        // Normals are keyed by UTC day and hour, so departures come before --tz
+        Climatology normals;
+        if (!departure.empty())
+            normals = Climatology::loadOrBuild(files); // Cached as <file>.clim
 
-    if (doPlot)    ASCIIPlotter::plot(candles);  // Plot ASCII chart
-    if (doPredict) {                            // Perform prediction
+        AnomalyDetector detect(detector);
+        // Detection sees the unfiltered series so filters cannot hide outliers
+        // or break up the window; only anomalies inside the date range are kept
+        auto scan = [&](const std::vector<WeatherRecord>& rows) {
+            if (!doAnomalies) return;
+            for (auto& r : rows)              // One O(1) update per reading
+                if (unsigned f = detect.update(r.temperature))
+                    if (inDates.matches(r))
+                        result.anomalies.push_back(
+                            {std::string(r.timestamp), r.temperature, f});
+        };
+        if (memLimit > 0) {
+            // Bounded mode: filter and aggregate window by window; several
+            // files are merged by timestamp while streaming, with the same
+            // duplicate rule as the in-memory loader
+            try {
+                BoundedAggregator agg(period, memLimit, doQuantiles);
+                MultiFileLoader::stream(files, country, agg.windowRows(),
+                    [&](WeatherDataset& window) {
+                        if (!departure.empty())
+                            normals.departures(window, country, departure == "z");
+                        if (!tzName.empty()) zone.localise(window);
+                        scan(window.records);
+                        for (auto& r : window.records)
+                            if (filter.matches(r)) agg.add(r);
+                    });
+                result.candles = agg.finish();
+            } catch (const std::runtime_error& e) {
+                std::cerr << e.what() << '\n';  // Unsorted input, no spill file, ...
+                return 1;
+            }
+        } else {
+            // Load data for specified country (files parsed in parallel), or
+            // the country minus another one for difference candles
+            auto data = diffWith.empty()
+                ? MultiFileLoader::load(files, country)
+                : CountryComparison::difference(MultiFileLoader::load(files, country),
+                                                MultiFileLoader::load(files, diffWith));
+            if (doFill) {                     // Regular hourly grid
+                data = GapFiller::resample(data.records, fill, result.gaps);
+                result.filled = true;
+            }
+            if (!departure.empty())
+                normals.departures(data, country, departure == "z");
+            if (!tzName.empty()) zone.localise(data);
+            scan(data.records);
+            // Apply date, temperature and --where filters in one pass
+            data.records = filter.apply(data.records);
+            // Build candlestick data
+            result.candles = CandlestickBuilder::build(data.records, period, doQuantiles);
+        }
+        if (doAnomalies) tagCandles(result.candles, result.anomalies, period);
         std::vector<double> avgs;
-        for (auto& c : candles)                  // Compute average per candle
+        for (auto& c : result.candles)        // Compute average per candle
             avgs.push_back((c.open + c.close + c.high + c.low) / 4.0);
-        std::cout << "Predicted next average: "
-                  << Predictor::predictNextAverage(avgs)
-                  << '\n';                  // Output prediction
+        result.prediction = Predictor::predictNextAverage(avgs);
+        if (!cacheDir.empty()) ResultCache(cacheDir).store(inputs, query, result);
+    }
+
+    const std::vector<Candlestick>& candles = result.candles;
+    if (result.filled) {                        // Report what resampling found
+        const GapStats& gs = result.gaps;
+        std::cout << "Gaps: " << gs.missingHours << " missing hours in "
+                  << gs.gaps << " gaps (longest " << gs.longestGap
+                  << "h) over " << gs.gridHours << " hours, "
+                  << gs.dropped << " readings dropped\n";
     }
+    if (doAnomalies)                            // Report flagged readings
+        for (auto& a : result.anomalies)
+            std::cout << "Anomaly " << a.timestamp << ' ' << a.temperature
+                      << ' ' << AnomalyDetector::describe(a.flags) << '\n';
+    std::vector<IndicatorSeries> indicators;  // One series per window
+    if (!indicatorWindows.empty()) {
+        indicators = IndicatorEngine::compute(candles, indicatorWindows);
+        IndicatorEngine::print(candles, indicators);
+    }
+    if (!exportPath.empty())                    // Machine-readable output
+        CandleExporter::write(exportPath, candles, exportFormat);
+    if (doPlot)                                 // Plot ASCII chart
+        ASCIIPlotter::plot(candles, indicators.empty() ? nullptr : &indicators[0]);
+    if (doPredict)                              // Perform prediction
+        std::cout << "Predicted next average: " << result.prediction
+                  << '\n';                  // Output prediction
     return 0;                                  // Successful exit
 }
@@ -0,0 +1,229 @@
+#include "Decimal.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include "WideInt.h"
+
+namespace
+{
+    const std::int64_t kPow10[Decimal::kMaxScale + 1] = {
+        1LL, 10LL, 100LL, 1000LL, 10000LL, 100000LL, 1000000LL, 10000000LL,
+        100000000LL, 1000000000LL, 10000000000LL, 100000000000LL, 1000000000000LL,
+        10000000000000LL, 100000000000000LL, 1000000000000000LL,
+        10000000000000000LL, 100000000000000000LL, 1000000000000000000LL};
+
+    void checkScale(int scale)
+    {
+        if (scale < 0 || scale > Decimal::kMaxScale)
+        {
+            throw std::invalid_argument("Decimal: scale must be 0.." + std::to_string(Decimal::kMaxScale));
+        }
+    }
+
+    std::int64_t narrow(WideInt wide)
+    {
+        if (wide > std::numeric_limits<std::int64_t>::max()
+            || wide < std::numeric_limits<std::int64_t>::min())
+        {
+            throw std::overflow_error("Decimal: value out of range");
+        }
+        return (std::int64_t)wide;
+    }
+}
+
+WideInt divideRounded(WideInt n, WideInt d)
+{
+    WideInt q = n / d;
+    WideInt r = n % d;
+    if (2 * (r < 0 ? -r : r) >= d)
+    {
+        q += n < 0 ? -1 : 1;
+    }
+    return q;
+}
+
+Decimal::Decimal(std::int64_t units, int scale) : value(units), digits(scale)
+{
+    checkScale(scale);
+}
+
+std::int64_t Decimal::pow10(int n)
+{
+    return kPow10[n];
+}
+
+Decimal Decimal::parse(std::string_view text, int scale)
+{
+    checkScale(scale);
+    std::size_t i = 0;
+    bool negative = false;
+    if (i < text.size() && (text[i] == '-' || text[i] == '+'))
+    {
+        negative = text[i++] == '-';
+    }
+
+    // accumulate digits as units; past the scale only zeros are allowed
+    const std::uint64_t limit = (std::uint64_t)std::numeric_limits<std::int64_t>::max() + negative;
+    std::uint64_t units = 0;
+    bool any = false;
+    bool point = false;
+    int decimals = 0;
+    for (; i < text.size(); ++i)
+    {
+        char c = text[i];
+        if (c == '.' && !point)
+        {
+            point = true;
+            continue;
+        }
+        unsigned d = (unsigned)(c - '0');
+        if (d > 9)
+        {
+            throw std::invalid_argument("Decimal::parse: not a number: " + std::string(text));
+        }
+        any = true;
+        if (point && decimals == scale)
+        {
+            if (d != 0)
+            {
+                throw std::invalid_argument("Decimal::parse: more than " + std::to_string(scale)
+                                            + " decimals: " + std::string(text));
+            }
+            continue;
+        }
+        if (units > (limit - d) / 10)
+        {
+            throw std::overflow_error("Decimal::parse: out of range: " + std::string(text));
+        }
+        units = units * 10 + d;
+        decimals += point;
+    }
+    if (!any)
+    {
+        throw std::invalid_argument("Decimal::parse: not a number: " + std::string(text));
+    }
+
+    std::uint64_t pad = (std::uint64_t)kPow10[scale - decimals];
+    if (units > limit / pad)
+    {
+        throw std::overflow_error("Decimal::parse: out of range: " + std::string(text));
+    }
+    units *= pad;
+    return Decimal(negative ? (std::int64_t)(0 - units) : (std::int64_t)units, scale);
+}
+
+Decimal Decimal::fromDouble(double value, int scale)
+{
+    checkScale(scale);
+    double units = std::round(value * (double)kPow10[scale]);
+    if (!(std::fabs(units) < 9.2e18))
+    {
+        throw std::overflow_error("Decimal::fromDouble: out of range");
+    }
+    return Decimal((std::int64_t)units, scale);
+}
+
+Decimal Decimal::rescaled(int scale) const
+{
+    checkScale(scale);
+    if (scale >= digits)
+    {
+        return Decimal(narrow((WideInt)value * kPow10[scale - digits]), scale);
+    }
+    std::int64_t step = kPow10[digits - scale];
+    if (value % step != 0)
+    {
+        throw std::invalid_argument("Decimal::rescaled: " + toString() + " has more than "
+                                    + std::to_string(scale) + " decimals");
+    }
+    return Decimal(value / step, scale);
+}
+
+Decimal Decimal::rounded(int scale) const
+{
+    checkScale(scale);
+    if (scale >= digits)
+    {
+        return rescaled(scale);
+    }
+    return Decimal((std::int64_t)divideRounded(value, kPow10[digits - scale]), scale);
+}
+
+double Decimal::toDouble() const
+{
+    return (double)value / (double)kPow10[digits];
+}
+
+std::string Decimal::toString() const
+{
+    std::uint64_t magnitude = value < 0 ? 0 - (std::uint64_t)value : (std::uint64_t)value;
+    std::uint64_t step = (std::uint64_t)kPow10[digits];
+    std::string text = value < 0 ? "-" : "";
+    text += std::to_string(magnitude / step);
+    if (digits > 0)
+    {
+        std::string fraction = std::to_string(magnitude % step);
+        text += '.';
+        text.append(digits - fraction.size(), '0');
+        text += fraction;
+    }
+    return text;
+}
+
+Decimal Decimal::operator-() const
+{
+    return Decimal(narrow(-(WideInt)value), digits);
+}
+
+Decimal &Decimal::operator+=(const Decimal &other)
+{
+    int scale = std::max(digits, other.digits);
+    WideInt a = (WideInt)value * kPow10[scale - digits];
+    WideInt b = (WideInt)other.value * kPow10[scale - other.digits];
+    value = narrow(a + b);
+    digits = scale;
+    return *this;
+}
+
+Decimal &Decimal::operator-=(const Decimal &other)
+{
+    int scale = std::max(digits, other.digits);
+    WideInt a = (WideInt)value * kPow10[scale - digits];
+    WideInt b = (WideInt)other.value * kPow10[scale - other.digits];
+    value = narrow(a - b);
+    digits = scale;
+    return *this;
+}
+
+Decimal operator*(const Decimal &a, const Decimal &b)
+{
+    // the exact product has a.digits + b.digits decimals; drop the coarser scale's worth
+    int scale = std::max(a.digits, b.digits);
+    WideInt product = (WideInt)a.value * b.value;
+    return Decimal(narrow(divideRounded(product, kPow10[std::min(a.digits, b.digits)])), scale);
+}
+
+Decimal operator/(const Decimal &a, std::int64_t n)
+{
+    if (n == 0)
+    {
+        throw std::invalid_argument("Decimal: division by zero");
+    }
+    WideInt q = divideRounded(n < 0 ? -(WideInt)a.value : (WideInt)a.value,
+                              n < 0 ? -(WideInt)n : (WideInt)n);
+    return Decimal(narrow(q), a.digits);
+}
+
+int compare(const Decimal &a, const Decimal &b)
+{
+    int scale = std::max(a.digits, b.digits);
+    WideInt x = (WideInt)a.value * kPow10[scale - a.digits];
+    WideInt y = (WideInt)b.value * kPow10[scale - b.digits];
+    return x < y ? -1 : x > y ? 1 : 0;
+}
+
+std::ostream &operator<<(std::ostream &out, const Decimal &d)
+{
+    return out << d.toString();
+}
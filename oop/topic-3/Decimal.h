@@ -0,0 +1,84 @@
+// Decimal.h
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+/**
+ * Fixed-point decimal: an integer count of units of 10^-scale, so
+ * 0.02186299 at scale 8 is 2186299 units. Each product picks the scale
+ * its prices and amounts are quoted in, and at that scale equal prices
+ * have equal units, so they can key price levels directly.
+ *
+ * Addition, subtraction and comparison are exact, across scales too (the
+ * finer scale wins). Multiplication and division round half away from
+ * zero. Anything that would overflow the 64-bit units throws
+ * std::overflow_error instead of wrapping.
+ */
+class Decimal
+{
+public:
+    /** the finest scale; 10^18 still fits the units */
+    static const int kMaxScale = 18;
+
+    /** zero */
+    Decimal() = default;
+
+    /** `units` * 10^-scale */
+    Decimal(std::int64_t units, int scale);
+
+    /** read plain decimal text ("0.02186299", "-12", ".5") at `scale`;
+     *  throws std::invalid_argument on anything else or on non-zero
+     *  digits finer than the scale */
+    static Decimal parse(std::string_view text, int scale);
+
+    /** nearest value at `scale` */
+    static Decimal fromDouble(double value, int scale);
+
+    std::int64_t units() const { return value; }
+    int scale() const { return digits; }
+
+    /** the same value at another scale; throws std::invalid_argument if
+     *  that would lose digits */
+    Decimal rescaled(int scale) const;
+
+    /** the nearest value at another scale */
+    Decimal rounded(int scale) const;
+
+    double toDouble() const;
+
+    /** exact text with `scale` decimals, e.g. "0.02186299" */
+    std::string toString() const;
+
+    Decimal operator-() const;
+    Decimal &operator+=(const Decimal &other);
+    Decimal &operator-=(const Decimal &other);
+
+    friend Decimal operator+(Decimal a, const Decimal &b) { return a += b; }
+    friend Decimal operator-(Decimal a, const Decimal &b) { return a -= b; }
+
+    /** product, rounded to the finer of the two scales */
+    friend Decimal operator*(const Decimal &a, const Decimal &b);
+
+    /** quotient by a count (e.g. for averages), rounded at the same scale */
+    friend Decimal operator/(const Decimal &a, std::int64_t n);
+
+    friend int compare(const Decimal &a, const Decimal &b);
+    friend bool operator==(const Decimal &a, const Decimal &b) { return compare(a, b) == 0; }
+    friend bool operator!=(const Decimal &a, const Decimal &b) { return compare(a, b) != 0; }
+    friend bool operator<(const Decimal &a, const Decimal &b) { return compare(a, b) < 0; }
+    friend bool operator<=(const Decimal &a, const Decimal &b) { return compare(a, b) <= 0; }
+    friend bool operator>(const Decimal &a, const Decimal &b) { return compare(a, b) > 0; }
+    friend bool operator>=(const Decimal &a, const Decimal &b) { return compare(a, b) >= 0; }
+
+    friend std::ostream &operator<<(std::ostream &out, const Decimal &d);
+
+    /** 10^n for 0 <= n <= kMaxScale */
+    static std::int64_t pow10(int n);
+
+private:
+    std::int64_t value = 0;
+    int digits = 0;
+};
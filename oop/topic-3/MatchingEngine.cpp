@@ -0,0 +1,285 @@
+#include "MatchingEngine.h"
+#include <algorithm>
+#include <stdexcept>
+
+MatchingEngine::MatchingEngine(int _priceScale, int _amountScale)
+    : priceScale(_priceScale), amountScale(_amountScale)
+{
+    if (priceScale < 0 || priceScale > Decimal::kMaxScale
+        || amountScale < 0 || amountScale > Decimal::kMaxScale)
+    {
+        throw std::invalid_argument("MatchingEngine: scales must be 0.." + std::to_string(Decimal::kMaxScale));
+    }
+}
+
+void MatchingEngine::setTradeListener(std::function<void(const Trade &)> listener)
+{
+    tradeListener = std::move(listener);
+}
+
+std::int64_t MatchingEngine::toTicks(const Decimal &price) const
+{
+    return price.rescaled(priceScale).units();
+}
+
+std::int64_t MatchingEngine::toLots(const Decimal &amount) const
+{
+    return amount.rescaled(amountScale).units();
+}
+
+MatchingEngine::OrderId MatchingEngine::submit(const OrderBookEntry &entry)
+{
+    return submit(entry.orderType, toTicks(entry.price), toLots(entry.amount));
+}
+
+MatchingEngine::OrderId MatchingEngine::submit(OrderBookType side, std::int64_t ticks,
+                                               std::int64_t lots)
+{
+    if (matching)
+    {
+        throw std::logic_error("MatchingEngine: submit called from the trade listener");
+    }
+    if (lots <= 0)
+    {
+        throw std::invalid_argument("MatchingEngine: amount must be > 0");
+    }
+    std::uint32_t taker = allocate(side, ticks, lots);
+    OrderId takerId = idOf(taker);
+
+    // take the oldest order of the opposite side's best level, one fill at
+    // a time, while the prices cross
+    bool isBid = side == OrderBookType::bid;
+    std::vector<Level> &book = isBid ? asks : bids;
+    matching = true;
+    while (nodes[taker].lots > 0 && !book.empty())
+    {
+        Level &level = book.back();
+        std::int64_t price = level.ticks;
+        if (isBid ? price > ticks : price < ticks)
+        {
+            break;
+        }
+        std::uint32_t maker = level.head;
+        OrderId makerId = idOf(maker);
+        Node &m = nodes[maker];
+        std::int64_t fill = std::min(nodes[taker].lots, m.lots);
+        nodes[taker].lots -= fill;
+        m.lots -= fill;
+        level.lots -= fill;
+        if (m.lots == 0)
+        {
+            level.head = m.next;
+            if (level.head != kNone)
+            {
+                nodes[level.head].prev = kNone;
+            }
+            release(maker);
+            resting--;
+        }
+        // a drained level leaves the book before the listener can query it
+        if (level.head == kNone)
+        {
+            book.pop_back();
+        }
+        if (tradeListener)
+        {
+            try
+            {
+                tradeListener(Trade{takerId, makerId, side, price, fill});
+            }
+            catch (...)
+            {
+                // the fills stand; the rest of the order is dropped, as
+                // resting it could cross the book
+                nodes[taker].lots = 0;
+                settle(taker);
+                throw;
+            }
+        }
+    }
+    settle(taker);
+    return takerId;
+}
+
+void MatchingEngine::settle(std::uint32_t taker)
+{
+    matching = false;
+    if (nodes[taker].lots > 0)
+    {
+        rest(taker);
+    }
+    else
+    {
+        release(taker);
+    }
+}
+
+void MatchingEngine::rest(std::uint32_t index)
+{
+    Node &n = nodes[index];
+    std::vector<Level> &levels = sideOf(n.side);
+    std::size_t i = find(levels, n.ticks, n.side);
+    if (i == levels.size() || levels[i].ticks != n.ticks)
+    {
+        levels.insert(levels.begin() + i, Level{n.ticks, 0, kNone, kNone});
+    }
+    Level &level = levels[i];
+    n.prev = level.tail;
+    n.next = kNone;
+    if (level.tail != kNone)
+    {
+        nodes[level.tail].next = index;
+    }
+    else
+    {
+        level.head = index;
+    }
+    level.tail = index;
+    level.lots += n.lots;
+    resting++;
+}
+
+bool MatchingEngine::cancel(OrderId id)
+{
+    if (matching)
+    {
+        throw std::logic_error("MatchingEngine: cancel called from the trade listener");
+    }
+    std::uint32_t index;
+    if (!lookup(id, index))
+    {
+        return false;
+    }
+    Node &n = nodes[index];
+    std::vector<Level> &levels = sideOf(n.side);
+    std::size_t i = find(levels, n.ticks, n.side);
+    Level &level = levels[i];
+    // unlink from the level's queue
+    if (n.prev != kNone)
+    {
+        nodes[n.prev].next = n.next;
+    }
+    else
+    {
+        level.head = n.next;
+    }
+    if (n.next != kNone)
+    {
+        nodes[n.next].prev = n.prev;
+    }
+    else
+    {
+        level.tail = n.prev;
+    }
+    level.lots -= n.lots;
+    if (level.head == kNone)
+    {
+        levels.erase(levels.begin() + i);
+    }
+    release(index);
+    resting--;
+    return true;
+}
+
+std::int64_t MatchingEngine::remaining(OrderId id) const
+{
+    std::uint32_t index;
+    return lookup(id, index) ? nodes[index].lots : 0;
+}
+
+bool MatchingEngine::bestBid(std::int64_t &ticks) const
+{
+    if (bids.empty())
+    {
+        return false;
+    }
+    ticks = bids.back().ticks;
+    return true;
+}
+
+bool MatchingEngine::bestAsk(std::int64_t &ticks) const
+{
+    if (asks.empty())
+    {
+        return false;
+    }
+    ticks = asks.back().ticks;
+    return true;
+}
+
+std::size_t MatchingEngine::depth(OrderBookType side) const
+{
+    return sideOf(side).size();
+}
+
+std::int64_t MatchingEngine::levelLots(OrderBookType side, std::size_t k) const
+{
+    const std::vector<Level> &levels = sideOf(side);
+    return levels[levels.size() - 1 - k].lots;
+}
+
+std::uint32_t MatchingEngine::allocate(OrderBookType side, std::int64_t ticks, std::int64_t lots)
+{
+    std::uint32_t index;
+    if (!freeSlots.empty())
+    {
+        index = freeSlots.back();
+        freeSlots.pop_back();
+    }
+    else
+    {
+        if (nodes.size() >= kNone)
+        {
+            throw std::length_error("MatchingEngine: too many live orders");
+        }
+        index = (std::uint32_t)nodes.size();
+        nodes.push_back(Node{0, 0, kNone, kNone, 0, side, false});
+    }
+    Node &n = nodes[index];
+    n.ticks = ticks;
+    n.lots = lots;
+    n.prev = n.next = kNone;
+    n.side = side;
+    n.live = true;
+    return index;
+}
+
+void MatchingEngine::release(std::uint32_t index)
+{
+    nodes[index].live = false;
+    nodes[index].generation++;   // old ids of this slot go stale
+    freeSlots.push_back(index);
+}
+
+MatchingEngine::OrderId MatchingEngine::idOf(std::uint32_t index) const
+{
+    return (OrderId)nodes[index].generation << 32 | index;
+}
+
+bool MatchingEngine::lookup(OrderId id, std::uint32_t &index) const
+{
+    index = (std::uint32_t)(id & 0xffffffff);
+    return index < nodes.size() && nodes[index].live
+        && nodes[index].generation == (std::uint32_t)(id >> 32);
+}
+
+std::vector<MatchingEngine::Level> &MatchingEngine::sideOf(OrderBookType side)
+{
+    return side == OrderBookType::bid ? bids : asks;
+}
+
+const std::vector<MatchingEngine::Level> &MatchingEngine::sideOf(OrderBookType side) const
+{
+    return side == OrderBookType::bid ? bids : asks;
+}
+
+std::size_t MatchingEngine::find(const std::vector<Level> &levels, std::int64_t ticks,
+                                 OrderBookType side)
+{
+    auto it = side == OrderBookType::bid
+        ? std::lower_bound(levels.begin(), levels.end(), ticks,
+                           [](const Level &l, std::int64_t t) { return l.ticks < t; })
+        : std::lower_bound(levels.begin(), levels.end(), ticks,
+                           [](const Level &l, std::int64_t t) { return l.ticks > t; });
+    return it - levels.begin();
+}
@@ -0,0 +1,129 @@
+// MatchingEngine.h
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "Decimal.h"
+#include "OrderBookEntry.h"
+
+/**
+ * Limit-order matching with price-time priority. An incoming bid trades
+ * against the lowest asks (an ask against the highest bids) as long as
+ * the prices cross, oldest order first within a price, at the resting
+ * order's price; whatever is left rests in the book. Orders can be
+ * partially filled and cancelled.
+ *
+ * Prices and amounts are fixed-point at the product's scales and matched
+ * as their integer units (ticks and lots), so fills are exact. Each
+ * price level is a FIFO queue threaded through the orders themselves
+ * (intrusive prev/next links), and the orders live in one pooled vector
+ * that reuses the slots of filled and cancelled orders, so steady-state
+ * matching allocates nothing.
+ */
+class MatchingEngine
+{
+public:
+    /** identifies an order; stale ids of filled or cancelled orders are rejected */
+    using OrderId = std::uint64_t;
+
+    /** one fill between an incoming (taker) and a resting (maker) order */
+    struct Trade
+    {
+        OrderId taker;
+        OrderId maker;
+        OrderBookType takerSide;
+        std::int64_t ticks;     // price, the maker's
+        std::int64_t lots;      // amount filled
+    };
+
+    /** decimals of the product's prices and amounts */
+    explicit MatchingEngine(int priceScale = OrderBookEntry::kScale,
+                            int amountScale = OrderBookEntry::kScale);
+
+    /** called for every fill, in the order they happen, while the incoming
+     *  order is still being matched: the listener may use the const
+     *  queries, which already reflect the fill (a level it emptied is
+     *  gone), but not submit or cancel (std::logic_error). If it throws,
+     *  the fills so far stand and the rest of the order is cancelled */
+    void setTradeListener(std::function<void(const Trade &)> listener);
+
+    /** match an order and rest what is left; the id is also the taker id
+     *  of its trades. Throws std::invalid_argument if the entry has more
+     *  decimals than the engine's scales */
+    OrderId submit(const OrderBookEntry &entry);
+    OrderId submit(OrderBookType side, std::int64_t ticks, std::int64_t lots);
+
+    /** take a resting order out; false if it was already filled or cancelled */
+    bool cancel(OrderId id);
+
+    /** lots still resting for an order (0 once filled or cancelled) */
+    std::int64_t remaining(OrderId id) const;
+
+    /** best prices in ticks; false when that side is empty */
+    bool bestBid(std::int64_t &ticks) const;
+    bool bestAsk(std::int64_t &ticks) const;
+
+    /** price levels on one side, and the total lots of the k-th best one */
+    std::size_t depth(OrderBookType side) const;
+    std::int64_t levelLots(OrderBookType side, std::size_t k) const;
+
+    /** resting orders, both sides */
+    std::size_t restingOrders() const { return resting; }
+
+    std::int64_t toTicks(const Decimal &price) const;
+    std::int64_t toLots(const Decimal &amount) const;
+    Decimal toPrice(std::int64_t ticks) const { return Decimal(ticks, priceScale); }
+    Decimal toAmount(std::int64_t lots) const { return Decimal(lots, amountScale); }
+
+private:
+    static const std::uint32_t kNone = 0xffffffff;
+
+    /** a pooled order; prev/next link it into its level's queue */
+    struct Node
+    {
+        std::int64_t ticks;
+        std::int64_t lots;
+        std::uint32_t prev;
+        std::uint32_t next;
+        std::uint32_t generation;   // bumped when the slot is freed
+        OrderBookType side;
+        bool live;
+    };
+
+    /** one price: a FIFO of orders, oldest at head */
+    struct Level
+    {
+        std::int64_t ticks;
+        std::int64_t lots;
+        std::uint32_t head;
+        std::uint32_t tail;
+    };
+
+    std::uint32_t allocate(OrderBookType side, std::int64_t ticks, std::int64_t lots);
+    void release(std::uint32_t index);
+    OrderId idOf(std::uint32_t index) const;
+    bool lookup(OrderId id, std::uint32_t &index) const;
+
+    /** bids ascending, asks descending: the best level is last */
+    std::vector<Level> &sideOf(OrderBookType side);
+    const std::vector<Level> &sideOf(OrderBookType side) const;
+    static std::size_t find(const std::vector<Level> &levels, std::int64_t ticks,
+                            OrderBookType side);
+
+    void rest(std::uint32_t index);
+
+    /** end of a match: rest what is left of the incoming order, or free it */
+    void settle(std::uint32_t taker);
+
+    int priceScale;
+    int amountScale;
+    std::vector<Node> nodes;
+    std::vector<std::uint32_t> freeSlots;
+    std::vector<Level> bids;
+    std::vector<Level> asks;
+    std::size_t resting = 0;
+    std::function<void(const Trade &)> tradeListener;
+    bool matching = false;      // inside submit's match loop, see setTradeListener
+};
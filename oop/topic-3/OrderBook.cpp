@@ -0,0 +1,183 @@
+#include "OrderBook.h"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+OrderBook::OrderBook(int _priceScale, int _amountScale)
+    : priceScale(_priceScale), amountScale(_amountScale)
+{
+    if (priceScale < 0 || priceScale > Decimal::kMaxScale
+        || amountScale < 0 || amountScale > Decimal::kMaxScale)
+    {
+        throw std::invalid_argument("OrderBook: scales must be 0.." + std::to_string(Decimal::kMaxScale));
+    }
+}
+
+std::int64_t OrderBook::toTicks(const Decimal &price) const
+{
+    return price.rescaled(priceScale).units();
+}
+
+std::int64_t OrderBook::toLots(const Decimal &amount) const
+{
+    return amount.rescaled(amountScale).units();
+}
+
+std::vector<OrderBook::Level> &OrderBook::sideOf(OrderBookType side)
+{
+    return side == OrderBookType::bid ? bids : asks;
+}
+
+const std::vector<OrderBook::Level> &OrderBook::sideOf(OrderBookType side) const
+{
+    return side == OrderBookType::bid ? bids : asks;
+}
+
+std::size_t OrderBook::find(const std::vector<Level> &levels, std::int64_t ticks,
+                            OrderBookType side)
+{
+    // bids are ascending and asks descending, so the best price is last
+    auto it = side == OrderBookType::bid
+        ? std::lower_bound(levels.begin(), levels.end(), ticks,
+                           [](const Level &l, std::int64_t t) { return l.ticks < t; })
+        : std::lower_bound(levels.begin(), levels.end(), ticks,
+                           [](const Level &l, std::int64_t t) { return l.ticks > t; });
+    return it - levels.begin();
+}
+
+void OrderBook::insert(const OrderBookEntry &entry)
+{
+    std::int64_t ticks = toTicks(entry.price);
+    std::int64_t lots = toLots(entry.amount);
+    std::vector<Level> &levels = sideOf(entry.orderType);
+    std::size_t i = find(levels, ticks, entry.orderType);
+    if (i == levels.size() || levels[i].ticks != ticks)
+    {
+        levels.insert(levels.begin() + i, Level{ticks, 0, 0});
+    }
+    else
+    {
+        WideInt total = (WideInt)levels[i].lots + lots;
+        if (total > std::numeric_limits<std::int64_t>::max()
+            || total < std::numeric_limits<std::int64_t>::min())
+        {
+            throw std::overflow_error("OrderBook::insert: amount at " + entry.price.toString()
+                                      + " out of range");
+        }
+    }
+    levels[i].lots += lots;
+    levels[i].orders++;
+    count++;
+    tickSum += ticks;
+}
+
+bool OrderBook::remove(const OrderBookEntry &entry)
+{
+    // an entry finer than the book's scales can never have been inserted
+    if (entry.price.rounded(priceScale) != entry.price
+        || entry.amount.rounded(amountScale) != entry.amount)
+    {
+        return false;
+    }
+    std::int64_t ticks = toTicks(entry.price);
+    std::int64_t lots = toLots(entry.amount);
+    std::vector<Level> &levels = sideOf(entry.orderType);
+    std::size_t i = find(levels, ticks, entry.orderType);
+    if (i == levels.size() || levels[i].ticks != ticks)
+    {
+        return false;
+    }
+    // the amount has to fit what rests there: all of it for the level's
+    // last order, at most the level's total otherwise
+    Level &level = levels[i];
+    if (level.orders == 1 ? lots != level.lots : lots > level.lots)
+    {
+        return false;
+    }
+    // the last order of a level takes the level with it
+    if (--level.orders == 0)
+    {
+        levels.erase(levels.begin() + i);
+    }
+    else
+    {
+        level.lots -= lots;
+    }
+    count--;
+    tickSum -= ticks;
+    return true;
+}
+
+std::size_t OrderBook::depth(OrderBookType side) const
+{
+    return sideOf(side).size();
+}
+
+const OrderBook::Level &OrderBook::level(OrderBookType side, std::size_t k) const
+{
+    const std::vector<Level> &levels = sideOf(side);
+    return levels[levels.size() - 1 - k];
+}
+
+Decimal OrderBook::amountAt(OrderBookType side, const Decimal &price) const
+{
+    // a price finer than the book's scale cannot have a level
+    Decimal exact = price.rounded(priceScale);
+    if (exact != price)
+    {
+        return toAmount(0);
+    }
+    std::int64_t ticks = exact.units();
+    const std::vector<Level> &levels = sideOf(side);
+    std::size_t i = find(levels, ticks, side);
+    return toAmount(i < levels.size() && levels[i].ticks == ticks ? levels[i].lots : 0);
+}
+
+Decimal OrderBook::bestBid() const
+{
+    return toPrice(bids.empty() ? 0 : bids.back().ticks);
+}
+
+Decimal OrderBook::bestAsk() const
+{
+    return toPrice(asks.empty() ? 0 : asks.back().ticks);
+}
+
+Decimal OrderBook::spread() const
+{
+    return toPrice(bids.empty() || asks.empty() ? 0 : asks.back().ticks - bids.back().ticks);
+}
+
+Decimal OrderBook::averagePrice() const
+{
+    // the mean of int64 ticks is itself within int64 range
+    return toPrice(count == 0 ? 0 : (std::int64_t)divideRounded(tickSum, (WideInt)count));
+}
+
+Decimal OrderBook::lowPrice() const
+{
+    // the lowest bid is the first bid level, the lowest ask the best one
+    if (count == 0)
+    {
+        return toPrice(0);
+    }
+    if (bids.empty() || asks.empty())
+    {
+        return toPrice(bids.empty() ? asks.back().ticks : bids.front().ticks);
+    }
+    return toPrice(std::min(bids.front().ticks, asks.back().ticks));
+}
+
+Decimal OrderBook::highPrice() const
+{
+    // the highest bid is the best one, the highest ask the first ask level
+    if (count == 0)
+    {
+        return toPrice(0);
+    }
+    if (bids.empty() || asks.empty())
+    {
+        return toPrice(bids.empty() ? asks.front().ticks : bids.back().ticks);
+    }
+    return toPrice(std::max(bids.back().ticks, asks.front().ticks));
+}
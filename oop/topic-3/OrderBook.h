@@ -0,0 +1,95 @@
+// OrderBook.h
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Decimal.h"
+#include "OrderBookEntry.h"
+#include "WideInt.h"
+
+/**
+ * Bids and asks aggregated into price levels. Prices and amounts are
+ * fixed-point at the product's scales, and levels are keyed by the price's
+ * integer units (ticks), so equal prices always land on the same level.
+ * Each side is a flat vector of levels sorted with the best price at the
+ * back: the best bid/ask, the spread and the lowest/highest price are
+ * O(1), finding a level is a binary search, and inserting near the top of
+ * the book (the usual case) moves only a few levels.
+ *
+ * Totals (entry count, tick sum, amounts) are updated on every insert and
+ * remove, so no query rescans the entries.
+ */
+class OrderBook
+{
+public:
+    /** one price level of one side */
+    struct Level
+    {
+        std::int64_t ticks;
+        std::int64_t lots;      // total amount resting at this price, in amount units
+        std::size_t orders;     // entries at this price
+    };
+
+    /** decimals of the product's prices and amounts */
+    explicit OrderBook(int priceScale = OrderBookEntry::kScale,
+                       int amountScale = OrderBookEntry::kScale);
+
+    /** add an entry to its side and level; throws std::invalid_argument if
+     *  its price or amount has more decimals than the book's scales, and
+     *  std::overflow_error if the level's total amount would not fit
+     *  64-bit units (the book is left unchanged) */
+    void insert(const OrderBookEntry &entry);
+
+    /** take an entry (same side, price and amount) back out; false if no
+     *  order rests at that price or the amount does not fit the level
+     *  (not the whole level for its last order, more than it otherwise) */
+    bool remove(const OrderBookEntry &entry);
+
+    /** number of entries in the book */
+    std::size_t size() const { return count; }
+
+    /** number of price levels on one side */
+    std::size_t depth(OrderBookType side) const;
+
+    /** `k`-th best level of a side (0 = best); k must be < depth(side) */
+    const Level &level(OrderBookType side, std::size_t k) const;
+
+    /** total amount resting at `price` on one side (0 if none), O(log n) */
+    Decimal amountAt(OrderBookType side, const Decimal &price) const;
+
+    /** best prices and their difference; 0 when the side is empty */
+    Decimal bestBid() const;
+    Decimal bestAsk() const;
+    Decimal spread() const;
+
+    /** statistics over every entry in the book, both sides; 0 when empty.
+     *  The average is rounded to the price scale, the rest are exact.
+     *  The price sum behind the average is kept in 128 bits, so it cannot
+     *  overflow however many entries there are */
+    Decimal averagePrice() const;
+    Decimal lowPrice() const;
+    Decimal highPrice() const;
+    Decimal priceRange() const { return highPrice() - lowPrice(); }
+
+    Decimal toPrice(std::int64_t ticks) const { return Decimal(ticks, priceScale); }
+    Decimal toAmount(std::int64_t lots) const { return Decimal(lots, amountScale); }
+    std::int64_t toTicks(const Decimal &price) const;
+    std::int64_t toLots(const Decimal &amount) const;
+
+private:
+    /** levels of one side; bids ascending, asks descending (best last) */
+    std::vector<Level> &sideOf(OrderBookType side);
+    const std::vector<Level> &sideOf(OrderBookType side) const;
+
+    /** position of `ticks` in a side, or where it would be inserted */
+    static std::size_t find(const std::vector<Level> &levels, std::int64_t ticks,
+                            OrderBookType side);
+
+    int priceScale;
+    int amountScale;
+    std::vector<Level> bids;
+    std::vector<Level> asks;
+    std::size_t count = 0;
+    WideInt tickSum = 0;        // integer sum: no rounding, no overflow
+};
@@ -0,0 +1,43 @@
+// OrderBookEntry.h
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include "Decimal.h"
+
+enum class OrderBookType : std::uint8_t
+{
+    bid,
+    ask
+};
+
+class OrderBookEntry
+{
+public:
+    /** decimals the exchange quotes prices and amounts in */
+    static const int kScale = 8;
+
+    std::string timestamp;
+    std::string product;
+    OrderBookType orderType;
+    Decimal price;
+    Decimal amount;
+
+    OrderBookEntry(std::string _timestamp,
+                   std::string _product,
+                   OrderBookType _orderType,
+                   Decimal _price,
+                   Decimal _amount)
+        : timestamp(_timestamp), product(_product),
+          orderType(_orderType), price(_price), amount(_amount) {}
+
+    /** prices and amounts given as doubles are rounded to kScale decimals */
+    OrderBookEntry(std::string _timestamp,
+                   std::string _product,
+                   OrderBookType _orderType,
+                   double _price,
+                   double _amount)
+        : OrderBookEntry(_timestamp, _product, _orderType,
+                         Decimal::fromDouble(_price, kScale),
+                         Decimal::fromDouble(_amount, kScale)) {}
+};
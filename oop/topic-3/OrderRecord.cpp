@@ -0,0 +1,95 @@
+#include "OrderRecord.h"
+#include <stdexcept>
+#include <string>
+#include "Timestamp.h"
+
+namespace
+{
+    /** scales the fields of `symbol` parse at: its own if it is known,
+     *  else the defaults intern() gives a new product. Interning comes
+     *  after parsing, so a bad line adds no product */
+    void scalesOf(const ProductDictionary &products, std::string_view symbol,
+                  int &priceScale, int &amountScale)
+    {
+        ProductDictionary::ProductId id;
+        if (products.find(symbol, id))
+        {
+            priceScale = products.product(id).priceScale;
+            amountScale = products.product(id).amountScale;
+        }
+        else
+        {
+            priceScale = amountScale = OrderBookEntry::kScale;
+        }
+    }
+}
+
+OrderRecord toRecord(const OrderBookEntry &entry, ProductDictionary &products,
+                     std::uint32_t sequence)
+{
+    OrderRecord record;
+    int priceScale, amountScale;
+    scalesOf(products, entry.product, priceScale, amountScale);
+    record.time = parseTimestamp(entry.timestamp);
+    record.price = entry.price.rescaled(priceScale).units();
+    record.amount = entry.amount.rescaled(amountScale).units();
+    record.sequence = sequence;
+    record.orderType = entry.orderType;
+    record.product = products.intern(entry.product);
+    return record;
+}
+
+OrderBookEntry toEntry(const OrderRecord &record, const ProductDictionary &products)
+{
+    const ProductDictionary::Product &p = products.product(record.product);
+    return OrderBookEntry(formatTimestamp(record.time), p.symbol, record.orderType,
+                          Decimal(record.price, p.priceScale),
+                          Decimal(record.amount, p.amountScale));
+}
+
+OrderRecord parseOrderLine(std::string_view line, ProductDictionary &products,
+                           std::uint32_t sequence)
+{
+    if (!line.empty() && line.back() == '\r')
+    {
+        line.remove_suffix(1);
+    }
+    std::string_view fields[5];
+    std::size_t start = 0;
+    for (int i = 0; i < 5; ++i)
+    {
+        std::size_t end = line.find(',', start);
+        if (i == 4 && end == std::string_view::npos)
+        {
+            end = line.size();
+        }
+        else if (i == 4 || end == std::string_view::npos)
+        {
+            throw std::invalid_argument("parseOrderLine: expected 5 fields: " + std::string(line));
+        }
+        fields[i] = line.substr(start, end - start);
+        start = end + 1;
+    }
+
+    OrderRecord record;
+    if (fields[2] == "bid")
+    {
+        record.orderType = OrderBookType::bid;
+    }
+    else if (fields[2] == "ask")
+    {
+        record.orderType = OrderBookType::ask;
+    }
+    else
+    {
+        throw std::invalid_argument("parseOrderLine: unknown order type: " + std::string(fields[2]));
+    }
+    int priceScale, amountScale;
+    scalesOf(products, fields[1], priceScale, amountScale);
+    record.time = parseTimestamp(fields[0]);
+    record.price = Decimal::parse(fields[3], priceScale).units();
+    record.amount = Decimal::parse(fields[4], amountScale).units();
+    record.sequence = sequence;
+    record.product = products.intern(fields[1]);
+    return record;
+}
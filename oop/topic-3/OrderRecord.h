@@ -0,0 +1,49 @@
+// OrderRecord.h
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+#include "OrderBookEntry.h"
+#include "ProductDictionary.h"
+
+/**
+ * Compact, trivially copyable form of an OrderBookEntry: the timestamp
+ * as microseconds (see Timestamp.h), the product as an interned id and
+ * the price and amount as integer units at the product's scales. Records
+ * are 32 bytes with no pointers, so millions of them sort, hash and copy
+ * as plain memory.
+ */
+struct OrderRecord
+{
+    std::int64_t time;          // microseconds since 1970-01-01
+    std::int64_t price;         // units at the product's price scale
+    std::int64_t amount;        // units at the product's amount scale
+    std::uint32_t sequence;     // position in the source, breaks time ties
+    ProductDictionary::ProductId product;
+    OrderBookType orderType;
+};
+
+static_assert(sizeof(OrderRecord) == 32, "OrderRecord should stay 32 bytes");
+static_assert(std::is_trivial<OrderRecord>::value, "OrderRecord should stay trivial");
+
+/** time order, then source order */
+inline bool earlier(const OrderRecord &a, const OrderRecord &b)
+{
+    return a.time != b.time ? a.time < b.time : a.sequence < b.sequence;
+}
+
+/** compact an entry, interning its product; throws std::invalid_argument
+ *  on a bad timestamp or a price/amount finer than the product's scales,
+ *  in which case no product is added */
+OrderRecord toRecord(const OrderBookEntry &entry, ProductDictionary &products,
+                     std::uint32_t sequence = 0);
+
+/** expand a record back into an entry */
+OrderBookEntry toEntry(const OrderRecord &record, const ProductDictionary &products);
+
+/** read one "timestamp,product,bid|ask,price,amount" line straight into a
+ *  record, without building any strings; throws std::invalid_argument on a
+ *  malformed line, without adding its product */
+OrderRecord parseOrderLine(std::string_view line, ProductDictionary &products,
+                           std::uint32_t sequence = 0);
@@ -0,0 +1,44 @@
+#include "ProductDictionary.h"
+#include <stdexcept>
+
+ProductDictionary::ProductId ProductDictionary::intern(std::string_view symbol,
+                                                       int priceScale, int amountScale)
+{
+    ProductId id;
+    if (find(symbol, id))
+    {
+        last = id;
+        return id;
+    }
+    if (products.size() > 0xffff)
+    {
+        throw std::length_error("ProductDictionary: too many products");
+    }
+    if (priceScale < 0 || priceScale > Decimal::kMaxScale
+        || amountScale < 0 || amountScale > Decimal::kMaxScale)
+    {
+        throw std::invalid_argument("ProductDictionary: scales must be 0.." + std::to_string(Decimal::kMaxScale));
+    }
+    id = (ProductId)products.size();
+    products.push_back(Product{std::string(symbol), priceScale, amountScale});
+    ids.emplace(products.back().symbol, id);
+    last = id;
+    return id;
+}
+
+bool ProductDictionary::find(std::string_view symbol, ProductId &id) const
+{
+    if (!products.empty() && products[last].symbol == symbol)
+    {
+        id = last;
+        return true;
+    }
+    // symbols are short, so the key string stays in its small buffer
+    auto it = ids.find(std::string(symbol));
+    if (it == ids.end())
+    {
+        return false;
+    }
+    id = it->second;
+    return true;
+}
@@ -0,0 +1,50 @@
+// ProductDictionary.h
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "OrderBookEntry.h"
+
+/**
+ * Interns product symbols ("ETH/BTC") as small integer ids, handed out
+ * 0, 1, 2, ... in order of first appearance, so records can carry a
+ * 2-byte id instead of a string. Each product also keeps the decimal
+ * scales of its prices and amounts.
+ */
+class ProductDictionary
+{
+public:
+    using ProductId = std::uint16_t;
+
+    /** one interned product */
+    struct Product
+    {
+        std::string symbol;
+        int priceScale;
+        int amountScale;
+    };
+
+    /** id of `symbol`, added with the given scales if it is new (the
+     *  scales of a known product are left alone); throws
+     *  std::length_error past 65536 products */
+    ProductId intern(std::string_view symbol,
+                     int priceScale = OrderBookEntry::kScale,
+                     int amountScale = OrderBookEntry::kScale);
+
+    /** id of a known symbol; false if it was never interned */
+    bool find(std::string_view symbol, ProductId &id) const;
+
+    const Product &product(ProductId id) const { return products[id]; }
+    const std::string &symbol(ProductId id) const { return products[id].symbol; }
+
+    std::size_t size() const { return products.size(); }
+
+private:
+    std::vector<Product> products;
+    std::unordered_map<std::string, ProductId> ids;
+    ProductId last = 0;     // consecutive orders are usually for one product
+};
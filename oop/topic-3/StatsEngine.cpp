@@ -0,0 +1,161 @@
+#include "StatsEngine.h"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+    const std::size_t kNone = std::numeric_limits<std::size_t>::max();
+
+    /** sums are kept in 128 bits; what reaches a Decimal has to fit its units */
+    std::int64_t narrow(WideInt wide, const char *what)
+    {
+        if (wide > std::numeric_limits<std::int64_t>::max()
+            || wide < std::numeric_limits<std::int64_t>::min())
+        {
+            throw std::overflow_error(std::string("SliceStats: ") + what + " out of range");
+        }
+        return (std::int64_t)wide;
+    }
+}
+
+Decimal SliceStats::averagePrice() const
+{
+    return Decimal(orders == 0 ? 0 : narrow(divideRounded(priceSum, orders), "average"),
+                   priceScale);
+}
+
+Decimal SliceStats::spread() const
+{
+    return Decimal(bids > 0 && asks > 0 ? bestAsk - bestBid : 0, priceScale);
+}
+
+Decimal SliceStats::vwap() const
+{
+    // notional carries amountScale extra decimals, which dividing by the
+    // volume (in amount units) takes away again
+    if (volume == 0)
+    {
+        return Decimal(0, priceScale);
+    }
+    return Decimal(narrow(divideRounded(notional, volume), "vwap"), priceScale);
+}
+
+Decimal SliceStats::totalVolume() const
+{
+    return Decimal(narrow(volume, "volume"), amountScale);
+}
+
+StatsEngine::StatsEngine(std::vector<OrderRecord> _records, const ProductDictionary &_products,
+                         std::int64_t sliceMicros)
+    : records(std::move(_records)), products(_products), width(sliceMicros)
+{
+    if (width <= 0)
+    {
+        throw std::invalid_argument("StatsEngine: slice width must be > 0");
+    }
+    if (!std::is_sorted(records.begin(), records.end(), earlier))
+    {
+        std::sort(records.begin(), records.end(), earlier);
+    }
+    slotOf.assign(products.size(), kNone);
+}
+
+std::int64_t StatsEngine::sliceOf(std::int64_t time) const
+{
+    // floor, so times before the epoch still land in the right slice
+    std::int64_t k = time / width;
+    if (time % width < 0)
+    {
+        k--;
+    }
+    return k * width;
+}
+
+void StatsEngine::rewind()
+{
+    for (const SliceStats &s : stats)
+    {
+        slotOf[s.product] = kNone;
+    }
+    stats.clear();
+    cursor = 0;
+    start = 0;
+}
+
+bool StatsEngine::next()
+{
+    // forget the previous slice's products only
+    for (const SliceStats &s : stats)
+    {
+        slotOf[s.product] = kNone;
+    }
+    stats.clear();
+    if (cursor == records.size())
+    {
+        return false;
+    }
+
+    start = sliceOf(records[cursor].time);
+    std::int64_t end = start + width;
+    for (; cursor < records.size() && records[cursor].time < end; ++cursor)
+    {
+        const OrderRecord &r = records[cursor];
+        std::size_t &slot = slotOf[r.product];
+        if (slot == kNone)
+        {
+            const ProductDictionary::Product &p = products.product(r.product);
+            slot = stats.size();
+            SliceStats s;
+            s.sliceStart = start;
+            s.product = r.product;
+            s.priceScale = p.priceScale;
+            s.amountScale = p.amountScale;
+            s.low = s.high = r.price;
+            stats.push_back(s);
+        }
+        SliceStats &s = stats[slot];
+        s.orders++;
+        s.low = std::min(s.low, r.price);
+        s.high = std::max(s.high, r.price);
+        s.priceSum += r.price;
+        s.volume += r.amount;
+        s.notional += (WideInt)r.price * r.amount;
+        if (r.orderType == OrderBookType::bid)
+        {
+            s.bestBid = s.bids++ == 0 ? r.price : std::max(s.bestBid, r.price);
+        }
+        else
+        {
+            s.bestAsk = s.asks++ == 0 ? r.price : std::min(s.bestAsk, r.price);
+        }
+    }
+
+    // a slice usually holds a handful of products, so this sort is cheap
+    std::sort(stats.begin(), stats.end(),
+              [](const SliceStats &a, const SliceStats &b) { return a.product < b.product; });
+    for (std::size_t i = 0; i < stats.size(); ++i)
+    {
+        slotOf[stats[i].product] = i;
+    }
+    return true;
+}
+
+const SliceStats *StatsEngine::find(ProductDictionary::ProductId product) const
+{
+    return product < slotOf.size() && slotOf[product] != kNone ? &stats[slotOf[product]] : nullptr;
+}
+
+std::vector<SliceStats> StatsEngine::computeAll(std::vector<OrderRecord> records,
+                                                const ProductDictionary &products,
+                                                std::int64_t sliceMicros)
+{
+    StatsEngine engine(std::move(records), products, sliceMicros);
+    std::vector<SliceStats> all;
+    while (engine.next())
+    {
+        all.insert(all.end(), engine.current().begin(), engine.current().end());
+    }
+    return all;
+}
@@ -0,0 +1,97 @@
+// StatsEngine.h
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Decimal.h"
+#include "OrderRecord.h"
+#include "ProductDictionary.h"
+#include "WideInt.h"
+
+/** statistics of one product over one time slice */
+struct SliceStats
+{
+    std::int64_t sliceStart;            // microseconds, see Timestamp.h
+    ProductDictionary::ProductId product;
+    int priceScale;
+    int amountScale;
+    std::size_t orders = 0;
+    std::size_t bids = 0;
+    std::size_t asks = 0;
+    std::int64_t low = 0;               // price units, over both sides
+    std::int64_t high = 0;
+    std::int64_t bestBid = 0;           // highest bid; valid when bids > 0
+    std::int64_t bestAsk = 0;           // lowest ask; valid when asks > 0
+
+    /** the sums behind these are kept in 128 bits, so they cannot
+     *  overflow; the accessors throw std::overflow_error if a value does
+     *  not fit 64-bit units */
+    Decimal averagePrice() const;
+    Decimal lowPrice() const { return Decimal(low, priceScale); }
+    Decimal highPrice() const { return Decimal(high, priceScale); }
+
+    /** best ask - best bid; 0 unless both sides have orders */
+    Decimal spread() const;
+
+    /** volume-weighted average price, rounded to the price scale */
+    Decimal vwap() const;
+    Decimal totalVolume() const;
+
+private:
+    friend class StatsEngine;
+    WideInt priceSum = 0;
+    WideInt volume = 0;                 // amount units, both sides
+    WideInt notional = 0;               // sum of price * amount units
+};
+
+/**
+ * Steps through order records one time slice at a time and keeps, for
+ * every product seen in the slice, its average, low, high, best bid/ask,
+ * spread, VWAP and volume. All of them are accumulated together in a
+ * single pass over the slice's records, and moving to the next slice
+ * costs only that slice's records (plus the products it touches); nothing
+ * before it is scanned again.
+ *
+ * Slices are [k * width, (k + 1) * width) in timestamp microseconds;
+ * a width of 1 gives one slice per distinct timestamp. Slices without
+ * records are skipped.
+ */
+class StatsEngine
+{
+public:
+    /** records are sorted by time first if they are not already */
+    StatsEngine(std::vector<OrderRecord> records, const ProductDictionary &products,
+                std::int64_t sliceMicros);
+
+    /** move to the next slice with records; false once they run out */
+    bool next();
+
+    /** back to before the first slice */
+    void rewind();
+
+    /** start of the current slice */
+    std::int64_t sliceStart() const { return start; }
+
+    /** stats of the current slice, one per product present, by product id */
+    const std::vector<SliceStats> &current() const { return stats; }
+
+    /** stats of one product in the current slice; nullptr if it had no orders */
+    const SliceStats *find(ProductDictionary::ProductId product) const;
+
+    /** every (slice, product) group in order, in one pass */
+    static std::vector<SliceStats> computeAll(std::vector<OrderRecord> records,
+                                              const ProductDictionary &products,
+                                              std::int64_t sliceMicros);
+
+private:
+    std::int64_t sliceOf(std::int64_t time) const;
+
+    std::vector<OrderRecord> records;
+    const ProductDictionary &products;
+    std::int64_t width;
+    std::size_t cursor = 0;             // first record not yet consumed
+    std::int64_t start = 0;
+    std::vector<SliceStats> stats;
+    std::vector<std::size_t> slotOf;    // product id -> index in stats, if present
+};
@@ -0,0 +1,116 @@
+#include "Timestamp.h"
+#include <cstdio>
+#include <stdexcept>
+
+namespace
+{
+    const std::int64_t kMicrosPerDay = 86400LL * 1000000;
+
+    /** days since 1970-01-01 of a proleptic Gregorian date */
+    std::int64_t daysFromCivil(int y, int m, int d)
+    {
+        y -= m <= 2;
+        const int era = (y >= 0 ? y : y - 399) / 400;
+        const int yoe = y - era * 400;
+        const int doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+        const int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+        return (std::int64_t)era * 146097 + doe - 719468;
+    }
+
+    /** the inverse; the year stays 64-bit, as an int64 day count can
+     *  reach beyond what an int year could hold in general */
+    void civilFromDays(std::int64_t z, std::int64_t &y, int &m, int &d)
+    {
+        z += 719468;
+        const std::int64_t era = (z >= 0 ? z : z - 146096) / 146097;
+        const int doe = (int)(z - era * 146097);
+        const int yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+        const int doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+        const int mp = (5 * doy + 2) / 153;
+        d = doy - (153 * mp + 2) / 5 + 1;
+        m = mp < 10 ? mp + 3 : mp - 9;
+        y = yoe + era * 400 + (m <= 2);
+    }
+
+    int daysInMonth(int y, int m)
+    {
+        static const int kDays[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+        bool leap = (y % 4 == 0 && y % 100 != 0) || y % 400 == 0;
+        return m == 2 && leap ? 29 : kDays[m - 1];
+    }
+
+    /** `n` digits at `pos` as a number, or -1 if any is not a digit */
+    int digitsAt(std::string_view text, std::size_t pos, int n)
+    {
+        int value = 0;
+        for (int i = 0; i < n; ++i)
+        {
+            unsigned d = (unsigned)(text[pos + i] - '0');
+            if (d > 9)
+            {
+                return -1;
+            }
+            value = value * 10 + (int)d;
+        }
+        return value;
+    }
+}
+
+std::int64_t parseTimestamp(std::string_view text)
+{
+    // fixed layout: YYYY/MM/DD HH:MM:SS[.ffffff]
+    if (text.size() < 19 || text[4] != '/' || text[7] != '/' || text[10] != ' '
+        || text[13] != ':' || text[16] != ':')
+    {
+        throw std::invalid_argument("parseTimestamp: bad timestamp: " + std::string(text));
+    }
+    int year = digitsAt(text, 0, 4);
+    int month = digitsAt(text, 5, 2);
+    int day = digitsAt(text, 8, 2);
+    int hour = digitsAt(text, 11, 2);
+    int minute = digitsAt(text, 14, 2);
+    int second = digitsAt(text, 17, 2);
+    if (year < 0 || month < 1 || month > 12 || day < 1 || day > daysInMonth(year, month)
+        || hour < 0 || hour > 23 || minute < 0 || minute > 59 || second < 0 || second > 59)
+    {
+        throw std::invalid_argument("parseTimestamp: bad timestamp: " + std::string(text));
+    }
+
+    int micros = 0;
+    if (text.size() > 19)
+    {
+        std::size_t n = text.size() - 20;
+        if (text[19] != '.' || n < 1 || n > 6 || (micros = digitsAt(text, 20, (int)n)) < 0)
+        {
+            throw std::invalid_argument("parseTimestamp: bad timestamp: " + std::string(text));
+        }
+        for (std::size_t i = n; i < 6; ++i)
+        {
+            micros *= 10;
+        }
+    }
+    return daysFromCivil(year, month, day) * kMicrosPerDay
+        + ((hour * 60 + minute) * 60 + second) * 1000000LL + micros;
+}
+
+std::string formatTimestamp(std::int64_t micros)
+{
+    std::int64_t days = micros / kMicrosPerDay;
+    std::int64_t rest = micros % kMicrosPerDay;
+    if (rest < 0)
+    {
+        days--;
+        rest += kMicrosPerDay;
+    }
+    std::int64_t y;
+    int m, d;
+    civilFromDays(days, y, m, d);
+    std::int64_t seconds = rest / 1000000;
+    // room for the widest output the format allows (a 20-character year,
+    // 11 per other field: 83 bytes), so snprintf never truncates
+    char buffer[96];
+    std::snprintf(buffer, sizeof(buffer), "%04lld/%02d/%02d %02d:%02d:%02d.%06d",
+                  (long long)y, m, d, (int)(seconds / 3600), (int)(seconds / 60 % 60),
+                  (int)(seconds % 60), (int)(rest % 1000000));
+    return buffer;
+}
@@ -0,0 +1,20 @@
+// Timestamp.h
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+/**
+ * Exchange timestamps such as "2020/03/17 17:01:24.884492" as int64
+ * microseconds since 1970-01-01 00:00:00 (the clock has no zone, so it
+ * is read as UTC). Integers compare, subtract and bucket into time
+ * slices without touching text.
+ */
+
+/** "YYYY/MM/DD HH:MM:SS" with an optional fraction of up to 6 digits;
+ *  throws std::invalid_argument on anything else */
+std::int64_t parseTimestamp(std::string_view text);
+
+/** back to text, always with 6 fraction digits */
+std::string formatTimestamp(std::int64_t micros);
@@ -0,0 +1,13 @@
+// WideInt.h
+#pragma once
+
+/**
+ * 128-bit integer for exact products and running sums of 64-bit units.
+ * It is a GCC/Clang extension (hence __extension__, which keeps
+ * -Wpedantic quiet), so it stays out of the public interfaces: only
+ * implementation files and private members use it.
+ */
+__extension__ typedef __int128 WideInt;
+
+/** n / d rounded half away from zero, the rounding Decimal uses; d > 0 */
+WideInt divideRounded(WideInt n, WideInt d);
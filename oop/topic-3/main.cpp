@@ -1,68 +1,8 @@
+// Build: g++ -std=c++17 -O2 main.cpp OrderBook.cpp Decimal.cpp -o orderbook
 #include <iostream>
 #include <vector>
-#include <string>
-#include <limits>
-
-enum class OrderBookType
-{
-    bid,
-    ask
-};
-
-class OrderBookEntry
-{
-public:
-    std::string timestamp;
-    std::string product;
-    OrderBookType orderType;
-    double price;
-    double amount;
-
-    OrderBookEntry(std::string _timestamp,
-                   std::string _product,
-                   OrderBookType _orderType,
-                   double _price,
-                   double _amount)
-        : timestamp(_timestamp), product(_product),
-          orderType(_orderType), price(_price), amount(_amount) {}
-};
-
-double computeAveragePrice(const std::vector<OrderBookEntry> &entries)
-{
-    if (entries.empty())
-        return 0;
-    double total = 0;
-    for (const auto &e : entries)
-        total += e.price;
-    return total / entries.size();
-}
-
-double computeLowPrice(const std::vector<OrderBookEntry> &entries)
-{
-    double minPrice = std::numeric_limits<double>::max();
-    for (const auto &e : entries)
-    {
-        if (e.price < minPrice)
-            minPrice = e.price;
-    }
-    return minPrice;
-}
-
-double computeHighPrice(const std::vector<OrderBookEntry> &entries)
-{
-    double maxPrice = std::numeric_limits<double>::lowest();
-    for (const auto &e : entries)
-    {
-        if (e.price > maxPrice)
-            maxPrice = e.price;
-    }
-    return maxPrice;
-}
-
-double computePriceSpread(const std::vector<OrderBookEntry> &entries)
-{
-    return computeHighPrice(entries) - computeLowPrice(entries);
-}
+#include "OrderBook.h"
+#include "OrderBookEntry.h"
 
 int main()
 {
@@ -72,10 +12,20 @@ int main()
     entries.emplace_back("2020/03/17 17:01:25.123456", "ETH/BTC", OrderBookType::ask, 0.02190000, 0.2);
     entries.emplace_back("2020/03/17 17:01:26.654321", "ETH/BTC", OrderBookType::bid, 0.02185000, 0.15);
 
-    std::cout << "Average Price: " << computeAveragePrice(entries) << std::endl;
-    std::cout << "Low Price: " << computeLowPrice(entries) << std::endl;
-    std::cout << "High Price: " << computeHighPrice(entries) << std::endl;
-    std::cout << "Price Spread: " << computePriceSpread(entries) << std::endl;
+    // the book keeps its statistics up to date as entries go in
+    OrderBook book;
+    for (const auto &e : entries)
+    {
+        book.insert(e);
+    }
+
+    std::cout << "Average Price: " << book.averagePrice() << std::endl;
+    std::cout << "Low Price: " << book.lowPrice() << std::endl;
+    std::cout << "High Price: " << book.highPrice() << std::endl;
+    std::cout << "Price Spread: " << book.priceRange() << std::endl;
+    std::cout << "Best Bid: " << book.bestBid() << std::endl;
+    std::cout << "Best Ask: " << book.bestAsk() << std::endl;
+    std::cout << "Bid/Ask Spread: " << book.spread() << std::endl;
 
     return 0;
 }
@@ -0,0 +1,86 @@
+// Build: g++ -std=c++17 -O2 replay_bench.cpp MatchingEngine.cpp Decimal.cpp -o replay_bench
+// Usage: ./replay_bench [orders]
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "MatchingEngine.h"
+
+/** one replayed message: a new limit order, or a cancel of an earlier one */
+struct Command
+{
+    bool isCancel;
+    OrderBookType side;
+    std::int64_t ticks;
+    std::int64_t lots;
+    std::size_t target;     // for a cancel: which earlier order
+};
+
+int main(int argc, char *argv[])
+{
+    std::size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+
+    // a random walk mid price; orders land a few ticks either side of it,
+    // some of them crossing, and about a quarter of messages are cancels
+    std::mt19937_64 rng(42);
+    std::vector<Command> commands;
+    commands.reserve(count);
+    std::int64_t mid = 2186299;
+    std::size_t submitted = 0;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        if (rng() % 64 == 0)
+        {
+            mid += (std::int64_t)(rng() % 5) - 2;
+        }
+        if (submitted > 0 && rng() % 4 == 0)
+        {
+            std::size_t back = 1 + rng() % std::min<std::size_t>(submitted, 1000);
+            commands.push_back(Command{true, OrderBookType::bid, 0, 0, submitted - back});
+            continue;
+        }
+        OrderBookType side = rng() % 2 ? OrderBookType::bid : OrderBookType::ask;
+        std::int64_t offset = (std::int64_t)(rng() % 20) - 3;
+        std::int64_t ticks = side == OrderBookType::bid ? mid - offset : mid + offset;
+        commands.push_back(Command{false, side, ticks, 1 + (std::int64_t)(rng() % 100), 0});
+        submitted++;
+    }
+
+    MatchingEngine engine;
+    std::size_t trades = 0;
+    std::int64_t volume = 0;
+    engine.setTradeListener([&](const MatchingEngine::Trade &t)
+    {
+        trades++;
+        volume += t.lots;
+    });
+
+    std::vector<MatchingEngine::OrderId> ids;
+    ids.reserve(submitted);
+    std::size_t cancelled = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (const Command &c : commands)
+    {
+        if (c.isCancel)
+        {
+            cancelled += engine.cancel(ids[c.target]);
+        }
+        else
+        {
+            ids.push_back(engine.submit(c.side, c.ticks, c.lots));
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "messages:  " << count << " (" << submitted << " orders, "
+              << count - submitted << " cancels, " << cancelled << " hit)" << std::endl;
+    std::cout << "trades:    " << trades << " (" << volume << " lots)" << std::endl;
+    std::cout << "resting:   " << engine.restingOrders() << " orders, "
+              << engine.depth(OrderBookType::bid) << " bid / "
+              << engine.depth(OrderBookType::ask) << " ask levels" << std::endl;
+    std::cout << "time:      " << seconds << " s, "
+              << (std::size_t)(count / seconds) << " messages/s" << std::endl;
+    return 0;
+}
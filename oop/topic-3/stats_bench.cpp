@@ -0,0 +1,77 @@
+// Build: g++ -std=c++17 -O2 stats_bench.cpp StatsEngine.cpp OrderRecord.cpp ProductDictionary.cpp Timestamp.cpp Decimal.cpp -o stats_bench
+// Usage: ./stats_bench [orders] [slice seconds]
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "OrderRecord.h"
+#include "ProductDictionary.h"
+#include "StatsEngine.h"
+#include "Timestamp.h"
+
+int main(int argc, char *argv[])
+{
+    std::size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2000000;
+    std::int64_t sliceMicros = (argc > 2 ? std::strtoll(argv[2], nullptr, 10) : 1) * 1000000;
+
+    // order book lines a few milliseconds apart, spread over five products
+    // that each random-walk around their own mid price
+    const char *symbols[] = {"ETH/BTC", "DOGE/BTC", "BTC/USDT", "ETH/USDT", "DOGE/USDT"};
+    double mids[] = {0.02186299, 0.00000022, 5352.0, 117.0, 0.0011};
+    std::mt19937_64 rng(42);
+    std::vector<std::string> lines;
+    lines.reserve(count);
+    std::int64_t time = parseTimestamp("2020/03/17 17:01:24");
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        time += (std::int64_t)(rng() % 5000);
+        int p = (int)(rng() % 5);
+        mids[p] *= 1 + ((double)(rng() % 201) - 100) * 1e-6;
+        bool bid = rng() % 2 == 0;
+        double price = mids[p] * (bid ? 0.999 : 1.001);
+        char line[128];
+        std::snprintf(line, sizeof(line), "%s,%s,%s,%.8f,%.8f", formatTimestamp(time).c_str(),
+                      symbols[p], bid ? "bid" : "ask", price, 0.001 * (1 + rng() % 10000));
+        lines.push_back(line);
+    }
+
+    ProductDictionary products;
+    std::vector<OrderRecord> records;
+    records.reserve(count);
+    auto start = std::chrono::steady_clock::now();
+    for (const std::string &line : lines)
+    {
+        records.push_back(parseOrderLine(line, products, (std::uint32_t)records.size()));
+    }
+    double parseSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    StatsEngine engine(std::move(records), products, sliceMicros);
+    std::size_t slices = 0;
+    std::size_t groups = 0;
+    SliceStats last{};      // first product of the last slice
+    while (engine.next())
+    {
+        slices++;
+        groups += engine.current().size();
+        last = engine.current().front();
+    }
+    double statsSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "orders:    " << count << " (" << products.size() << " products)" << std::endl;
+    std::cout << "slices:    " << slices << " (" << groups << " product groups)" << std::endl;
+    std::cout << "last:      " << formatTimestamp(last.sliceStart) << " "
+              << products.symbol(last.product) << ": avg " << last.averagePrice()
+              << ", low " << last.lowPrice() << ", high " << last.highPrice()
+              << ", spread " << last.spread() << ", vwap " << last.vwap()
+              << ", volume " << last.totalVolume() << std::endl;
+    std::cout << "parse:     " << parseSeconds << " s, "
+              << (std::size_t)(count / parseSeconds) << " lines/s" << std::endl;
+    std::cout << "stats:     " << statsSeconds << " s, "
+              << (std::size_t)(count / statsSeconds) << " orders/s" << std::endl;
+    return 0;
+}
@@ -0,0 +1,133 @@
+#include "Backtester.h"
+#include <algorithm>                             // For std::max
+#include <cmath>                                 // For sqrt, fabs, floor
+#include <stdexcept>
+
+namespace {
+const double kTradingDays = 252;                 // For annualising the Sharpe ratio
+}
+
+double CostModel::commission(long shares, double price) const {
+    if (shares == 0) return 0;
+    double n = std::fabs((double)shares);
+    return std::max(minimum, perShare * n + rate * n * price);
+}
+
+long CostModel::affordable(double cash, double price) const {
+    double paid = price * (1 + slippage);
+    if (cash <= 0 || paid <= 0) return 0;
+    // Commission in proportion to the shares, unless the minimum is larger
+    double n = std::floor(cash / (paid * (1 + rate) + perShare));
+    if (n > 0 && commission((long)n, price) > perShare * n + rate * n * price)
+        n = std::floor(std::max(0.0, cash - minimum) / paid);
+    long shares = (long)n;
+    while (shares > 0 && shares * fillPrice(shares, price) + commission(shares, price) > cash)
+        shares--;                              // Rounding at the boundary
+    return shares;
+}
+
+IndicatorCache::IndicatorCache(const OhlcvSeries& series, const std::vector<IndicatorSpec>& specs,
+                               WorkStealingPool& pool) {
+    std::vector<std::vector<double>*> slots;
+    std::vector<IndicatorSpec> todo;
+    for (auto& spec : specs) {
+        auto inserted = values.emplace(keyOf(spec), std::vector<double>());
+        if (!inserted.second) continue;        // Same spec asked for twice
+        slots.push_back(&inserted.first->second);
+        todo.push_back(spec);
+    }
+    pool.run(todo.size(), [&](std::size_t i) { Indicators::compute(series, todo[i], *slots[i]); });
+}
+
+const std::vector<double>& IndicatorCache::get(const IndicatorSpec& spec) const {
+    auto it = values.find(keyOf(spec));
+    if (it == values.end()) throw std::out_of_range("Indicator not in the cache");
+    return it->second;
+}
+
+IndicatorCache::Key IndicatorCache::keyOf(const IndicatorSpec& spec) {
+    bool macd = spec.kind == IndicatorSpec::kMacd || spec.kind == IndicatorSpec::kMacdSignal
+        || spec.kind == IndicatorSpec::kMacdHistogram;
+    // slow and signal only matter for MACD
+    return Key(spec.kind, spec.period, macd ? spec.slow : 0, macd ? spec.signal : 0);
+}
+
+BacktestResult Backtester::run(const OhlcvSeries& s, Strategy& strategy,
+                               const BacktestConfig& config) {
+    BacktestResult r;
+    Broker broker;
+    broker.money = broker.value = config.cash;
+    const std::vector<double>& fillAt = config.fill == FillPrice::kNextOpen ? s.open : s.close;
+    double peak = config.cash, previous = config.cash;
+    double sum = 0, sumSquares = 0;            // Of daily returns
+    std::size_t days = 0;
+    for (std::size_t i = 0; i < s.size(); ++i) {
+        // Orders placed on the previous bar
+        if (broker.all) {
+            broker.pending = config.costs.affordable(broker.money, fillAt[i]);
+            broker.all = false;
+        }
+        if (broker.pending != 0) {
+            long q = broker.pending;
+            double price = config.costs.fillPrice(q, fillAt[i]);
+            double fee = config.costs.commission(q, fillAt[i]);
+            broker.money -= q * price + fee;
+            broker.shares += q;
+            broker.pending = 0;
+            r.commission += fee;
+            r.trades++;
+        }
+        double equity = broker.money + broker.shares * s.close[i];
+        broker.value = equity;
+        if (i > 0 && previous != 0) {
+            double ret = equity / previous - 1;
+            sum += ret;
+            sumSquares += ret * ret;
+            days++;
+        }
+        previous = equity;
+        peak = std::max(peak, equity);
+        if (peak > 0) r.maxDrawdown = std::max(r.maxDrawdown, (peak - equity) / peak);
+        strategy.onBar(s, i, broker);
+    }
+    r.pnl = broker.value - config.cash;
+    r.totalReturn = config.cash != 0 ? r.pnl / config.cash : 0;
+    if (days > 1) {
+        double mean = sum / days;
+        double var = (sumSquares - sum * mean) / (days - 1);
+        if (var > 0) r.sharpe = mean / std::sqrt(var) * std::sqrt(kTradingDays);
+    }
+    return r;
+}
+
+std::vector<SweepRun> Backtester::sweep(const OhlcvSeries& series,
+                                        const std::vector<std::vector<int>>& grid,
+                                        const StrategyFactory& factory,
+                                        const BacktestConfig& config, WorkStealingPool& pool) {
+    std::vector<IndicatorSpec> needed;
+    for (auto& params : grid)
+        for (auto& spec : factory.indicators(params)) needed.push_back(spec);
+    IndicatorCache cache(series, needed, pool);
+
+    std::vector<SweepRun> runs(grid.size());
+    pool.run(grid.size(), [&](std::size_t i) {
+        std::unique_ptr<Strategy> strategy = factory.make(grid[i], cache);
+        runs[i].params = grid[i];
+        runs[i].result = run(series, *strategy, config);
+    });
+    return runs;
+}
+
+std::vector<std::vector<int>> Backtester::grid(const std::vector<std::vector<int>>& values) {
+    std::vector<std::vector<int>> points{{}};
+    for (auto& axis : values) {
+        std::vector<std::vector<int>> next;
+        for (auto& p : points)
+            for (int v : axis) {
+                next.push_back(p);
+                next.back().push_back(v);
+            }
+        points = std::move(next);
+    }
+    return points;
+}
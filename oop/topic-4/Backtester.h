@@ -0,0 +1,122 @@
+#pragma once
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <tuple>
+#include <vector>
+#include "Indicators.h"
+#include "OhlcvSeries.h"
+#include "WorkStealingPool.h"
+
+// Price an order fills at: the bar after the one it was placed on
+enum class FillPrice { kNextOpen, kNextClose };
+
+// Trading costs of one fill
+struct CostModel {
+    double perShare = 0;                       // Commission per share
+    double rate = 0;                           // Commission as a fraction of traded value
+    double minimum = 0;                        // Least commission per fill
+    double slippage = 0;                       // Fraction of the price lost per fill, against us
+
+    // Price actually paid (shares > 0) or received (shares < 0)
+    double fillPrice(long shares, double price) const {
+        return shares > 0 ? price * (1 + slippage) : price * (1 - slippage);
+    }
+    double commission(long shares, double price) const;
+    // Most shares `cash` buys at `price`, slippage and commission included
+    long affordable(double cash, double price) const;
+};
+
+struct BacktestConfig {
+    double cash = 100000;                      // Starting capital
+    FillPrice fill = FillPrice::kNextOpen;
+    CostModel costs;
+};
+
+struct BacktestResult {
+    double pnl = 0;                            // Final equity - starting cash
+    double totalReturn = 0;                    // pnl / starting cash
+    double maxDrawdown = 0;                    // Largest fall from a peak, as a fraction
+    double sharpe = 0;                         // Annualised, from daily equity returns
+    int trades = 0;                            // Fills
+    double commission = 0;                     // Paid in total
+};
+
+// A strategy's view of its account. Orders are market orders for a number
+// of shares (negative = sell); they fill on the next bar.
+class Broker {
+public:
+    long position() const { return shares; }
+    double cash() const { return money; }
+    double equity() const { return value; }    // Marked to the last close
+
+    void order(long delta) { pending += delta; all = false; }
+    // Order whatever brings the position (after pending orders) to `target`
+    void target(long target) { pending = target - shares; all = false; }
+    // Buy as many shares as the cash pays for, sized at the fill price and
+    // costs of the next bar; replaces pending orders
+    void buyAll() { pending = 0; all = true; }
+
+private:
+    friend class Backtester;
+    long shares = 0;
+    long pending = 0;
+    bool all = false;                          // buyAll() pending
+    double money = 0;
+    double value = 0;
+};
+
+// Trading logic, called once per bar after it closes
+class Strategy {
+public:
+    virtual ~Strategy() = default;
+    virtual void onBar(const OhlcvSeries& series, std::size_t i, Broker& broker) = 0;
+};
+
+// Indicators of one series computed once and shared, read-only, by all
+// the runs of a sweep
+class IndicatorCache {
+public:
+    IndicatorCache(const OhlcvSeries& series, const std::vector<IndicatorSpec>& specs,
+                   WorkStealingPool& pool);
+
+    // Values of a spec that was passed in; throws std::out_of_range otherwise
+    const std::vector<double>& get(const IndicatorSpec& spec) const;
+
+private:
+    using Key = std::tuple<int, int, int, int>;
+    static Key keyOf(const IndicatorSpec& spec);
+    std::map<Key, std::vector<double>> values;
+};
+
+// Makes the strategy for one point of a parameter grid
+class StrategyFactory {
+public:
+    virtual ~StrategyFactory() = default;
+    // Indicators the strategy with these parameters reads from the cache
+    virtual std::vector<IndicatorSpec> indicators(const std::vector<int>& params) const = 0;
+    virtual std::unique_ptr<Strategy> make(const std::vector<int>& params,
+                                           const IndicatorCache& cache) const = 0;
+};
+
+struct SweepRun {
+    std::vector<int> params;
+    BacktestResult result;
+};
+
+class Backtester {
+public:
+    // Replay the series bar by bar through the strategy
+    static BacktestResult run(const OhlcvSeries& series, Strategy& strategy,
+                              const BacktestConfig& config);
+
+    // One run per parameter set, spread over the pool. The indicators all
+    // the runs need are computed once up front. Results are in grid order.
+    static std::vector<SweepRun> sweep(const OhlcvSeries& series,
+                                       const std::vector<std::vector<int>>& grid,
+                                       const StrategyFactory& factory,
+                                       const BacktestConfig& config, WorkStealingPool& pool);
+
+    // Every combination of the given values, first parameter slowest
+    static std::vector<std::vector<int>> grid(const std::vector<std::vector<int>>& values);
+};
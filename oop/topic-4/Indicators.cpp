@@ -0,0 +1,191 @@
+#include "Indicators.h"
+#include <algorithm>                             // For std::min
+#include <atomic>                                // Next series to take
+#include <limits>                                // For quiet_NaN
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+namespace {
+const double kNaN = std::numeric_limits<double>::quiet_NaN();
+
+// Scratch space reused by the kernels of one thread
+thread_local std::vector<double> prefix, scratchA, scratchB;
+
+void checkPeriod(int period) {
+    if (period < 1) throw std::invalid_argument("Indicator period must be positive");
+}
+
+// Sum of each `period`-long window ending at i, NaN before the first full
+// one: a prefix-sum pass, then one independent subtraction per row
+void windowSums(const double* x, std::size_t n, int period, double* out) {
+    prefix.resize(n + 1);
+    double* p = prefix.data();
+    p[0] = 0;
+    for (std::size_t i = 0; i < n; ++i) p[i + 1] = p[i] + x[i];
+    std::size_t w = (std::size_t)period;
+    std::size_t warm = std::min(n, w - 1);
+    for (std::size_t i = 0; i < warm; ++i) out[i] = kNaN;
+    for (std::size_t i = warm; i < n; ++i) out[i] = p[i + 1] - p[i + 1 - w];
+}
+}
+
+void Indicators::sma(const double* x, std::size_t n, int period, double* out) {
+    checkPeriod(period);
+    windowSums(x, n, period, out);
+    double scale = 1.0 / period;
+    for (std::size_t i = 0; i < n; ++i) out[i] *= scale;
+}
+
+void Indicators::ema(const double* x, std::size_t n, int period, double* out) {
+    checkPeriod(period);
+    std::size_t w = (std::size_t)period;
+    if (n < w) {
+        std::fill(out, out + n, kNaN);
+        return;
+    }
+    double seed = 0;
+    for (std::size_t i = 0; i < w; ++i) {
+        seed += x[i];
+        out[i] = kNaN;
+    }
+    double alpha = 2.0 / (period + 1), e = seed / period;
+    out[w - 1] = e;
+    for (std::size_t i = w; i < n; ++i) {
+        e += alpha * (x[i] - e);
+        out[i] = e;
+    }
+}
+
+void Indicators::rsi(const double* close, std::size_t n, int period, double* out) {
+    checkPeriod(period);
+    std::size_t w = (std::size_t)period;
+    std::fill(out, out + std::min(n, w), kNaN);
+    if (n <= w) return;
+    // Gains and losses of each day (vectorised), then Wilder's smoothing
+    scratchA.resize(n);
+    scratchB.resize(n);
+    double* gain = scratchA.data();
+    double* loss = scratchB.data();
+    gain[0] = loss[0] = 0;
+    for (std::size_t i = 1; i < n; ++i) {
+        double d = close[i] - close[i - 1];
+        gain[i] = d > 0 ? d : 0;
+        loss[i] = d < 0 ? -d : 0;
+    }
+    double g = 0, l = 0;
+    for (std::size_t i = 1; i <= w; ++i) {
+        g += gain[i];
+        l += loss[i];
+    }
+    g /= period;
+    l /= period;
+    auto index = [](double g, double l) { return l == 0 ? 100.0 : 100.0 - 100.0 / (1.0 + g / l); };
+    out[w] = index(g, l);
+    for (std::size_t i = w + 1; i < n; ++i) {
+        g = (g * (period - 1) + gain[i]) / period;
+        l = (l * (period - 1) + loss[i]) / period;
+        out[i] = index(g, l);
+    }
+}
+
+void Indicators::macd(const double* close, std::size_t n, int fast, int slow, int signal,
+                      double* line, double* signalLine, double* histogram) {
+    checkPeriod(fast);
+    checkPeriod(slow);
+    checkPeriod(signal);
+    scratchA.resize(n);
+    scratchB.resize(n);
+    double* fastEma = scratchA.data();
+    double* value = scratchB.data();           // The MACD line
+    ema(close, n, fast, fastEma);
+    ema(close, n, slow, value);
+    for (std::size_t i = 0; i < n; ++i) value[i] = fastEma[i] - value[i];
+    if (line) std::copy(value, value + n, line);
+    if (!signalLine && !histogram) return;
+
+    // The signal line smooths the MACD line from its first defined value
+    std::size_t start = std::min(n, (std::size_t)std::max(fast, slow) - 1);
+    double* sig = signalLine ? signalLine : fastEma; // fastEma is free again
+    std::fill(sig, sig + start, kNaN);
+    ema(value + start, n - start, signal, sig + start);
+    if (histogram)
+        for (std::size_t i = 0; i < n; ++i) histogram[i] = value[i] - sig[i];
+}
+
+void Indicators::vwap(const double* high, const double* low, const double* close,
+                      const std::uint64_t* volume, std::size_t n, int period, double* out) {
+    checkPeriod(period);
+    scratchA.resize(n);
+    scratchB.resize(n);
+    double* pv = scratchA.data();
+    double* v = scratchB.data();
+    for (std::size_t i = 0; i < n; ++i) {
+        v[i] = (double)volume[i];
+        pv[i] = (high[i] + low[i] + close[i]) * (1.0 / 3) * v[i];
+    }
+    windowSums(pv, n, period, out);
+    windowSums(v, n, period, pv);              // pv is consumed: reuse it
+    for (std::size_t i = 0; i < n; ++i) out[i] = pv[i] > 0 ? out[i] / pv[i] : kNaN;
+}
+
+void Indicators::compute(const OhlcvSeries& s, const IndicatorSpec& spec,
+                         std::vector<double>& out) {
+    std::size_t n = s.size();
+    out.resize(n);
+    switch (spec.kind) {
+    case IndicatorSpec::kSma:
+        sma(s.close.data(), n, spec.period, out.data());
+        break;
+    case IndicatorSpec::kEma:
+        ema(s.close.data(), n, spec.period, out.data());
+        break;
+    case IndicatorSpec::kRsi:
+        rsi(s.close.data(), n, spec.period, out.data());
+        break;
+    case IndicatorSpec::kVwap:
+        vwap(s.high.data(), s.low.data(), s.close.data(), s.volume.data(), n, spec.period, out.data());
+        break;
+    case IndicatorSpec::kMacd:
+        macd(s.close.data(), n, spec.period, spec.slow, spec.signal, out.data(), nullptr, nullptr);
+        break;
+    case IndicatorSpec::kMacdSignal:
+        macd(s.close.data(), n, spec.period, spec.slow, spec.signal, nullptr, out.data(), nullptr);
+        break;
+    case IndicatorSpec::kMacdHistogram:
+        macd(s.close.data(), n, spec.period, spec.slow, spec.signal, nullptr, nullptr, out.data());
+        break;
+    }
+}
+
+void Indicators::computeBatch(const std::vector<OhlcvSeries>& series,
+                              const std::vector<IndicatorSpec>& specs,
+                              const Consumer& consume, unsigned threads) {
+    if (threads == 0) threads = std::thread::hardware_concurrency();
+    if (threads == 0) threads = 1;
+    if (threads > series.size()) threads = (unsigned)std::max<std::size_t>(series.size(), 1);
+
+    // Threads take the next series as they finish, so long and short
+    // histories balance out
+    std::atomic<std::size_t> next{0};
+    std::vector<std::string> failures(threads);
+    auto work = [&](unsigned id) {
+        try {
+            std::vector<std::vector<double>> values(specs.size());
+            for (std::size_t i; (i = next++) < series.size(); ) {
+                for (std::size_t k = 0; k < specs.size(); ++k)
+                    compute(series[i], specs[k], values[k]);
+                consume(i, values);
+            }
+        } catch (const std::exception& e) {
+            failures[id] = e.what();           // Rethrown on the calling thread
+            next = series.size();              // Stop the others early
+        }
+    };
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < threads; ++t) pool.emplace_back(work, t);
+    work(0);
+    for (auto& t : pool) t.join();
+    for (auto& f : failures)
+        if (!f.empty()) throw std::runtime_error(f);
+}
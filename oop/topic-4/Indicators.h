@@ -0,0 +1,57 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "OhlcvSeries.h"
+
+// One indicator to compute over a series
+struct IndicatorSpec {
+    enum Kind { kSma, kEma, kRsi, kVwap, kMacd, kMacdSignal, kMacdHistogram };
+    Kind kind;
+    int period;                                // Window; fast EMA for the MACD kinds
+    int slow = 26;                             // MACD only
+    int signal = 9;                            // MACD only
+};
+
+// Technical indicators over the columns of an OhlcvSeries. Every kernel
+// is O(n) whatever the window, writes n values to `out` and leaves NaN
+// where the window is not yet full. Where rows do not depend on each
+// other (window differences, gains/losses, typical prices) the loops are
+// plain array maps that the compiler vectorises; EMA-style smoothing is
+// inherently sequential. Inputs must be finite.
+class Indicators {
+public:
+    // Simple moving average of `period` values
+    static void sma(const double* x, std::size_t n, int period, double* out);
+
+    // Exponential moving average (alpha = 2 / (period + 1)), seeded with the
+    // SMA of the first `period` values
+    static void ema(const double* x, std::size_t n, int period, double* out);
+
+    // Relative strength index with Wilder's smoothing; first value at `period`
+    static void rsi(const double* close, std::size_t n, int period, double* out);
+
+    // MACD line (fast EMA - slow EMA), its signal line (EMA of the line) and
+    // the histogram (line - signal); any output may be null
+    static void macd(const double* close, std::size_t n, int fast, int slow, int signal,
+                     double* line, double* signalLine, double* histogram);
+
+    // Volume-weighted average of the typical price (high + low + close) / 3
+    // over a rolling `period`-day window
+    static void vwap(const double* high, const double* low, const double* close,
+                     const std::uint64_t* volume, std::size_t n, int period, double* out);
+
+    // One indicator over a series; `out` is resized to the series length
+    static void compute(const OhlcvSeries& series, const IndicatorSpec& spec,
+                        std::vector<double>& out);
+
+    // All `specs` over all `series`, the series spread over `threads`
+    // threads (0 = one per core). `consume(i, values)` is called on a worker
+    // thread once per series with values[k] holding specs[k]; the buffers
+    // are reused for the thread's next series, so keep what you need.
+    using Consumer = std::function<void(std::size_t, const std::vector<std::vector<double>>&)>;
+    static void computeBatch(const std::vector<OhlcvSeries>& series,
+                             const std::vector<IndicatorSpec>& specs,
+                             const Consumer& consume, unsigned threads = 0);
+};
@@ -0,0 +1,80 @@
+#include "OhlcvSeries.h"
+#include <cstdio>
+
+void OhlcvSeries::reserve(std::size_t rows) {
+    day.reserve(rows);
+    open.reserve(rows);
+    high.reserve(rows);
+    low.reserve(rows);
+    close.reserve(rows);
+    volume.reserve(rows);
+}
+
+void OhlcvSeries::push_back(std::int32_t d, double o, double h, double l, double c, std::uint64_t v) {
+    day.push_back(d);
+    open.push_back(o);
+    high.push_back(h);
+    low.push_back(l);
+    close.push_back(c);
+    volume.push_back(v);
+}
+
+void OhlcvSeries::append(const OhlcvSeries& other) {
+    day.insert(day.end(), other.day.begin(), other.day.end());
+    open.insert(open.end(), other.open.begin(), other.open.end());
+    high.insert(high.end(), other.high.begin(), other.high.end());
+    low.insert(low.end(), other.low.begin(), other.low.end());
+    close.insert(close.end(), other.close.begin(), other.close.end());
+    volume.insert(volume.end(), other.volume.begin(), other.volume.end());
+}
+
+StockEntry OhlcvSeries::entry(std::size_t i) const {
+    return StockEntry(formatDay(day[i]), close[i], high[i], low[i], open[i], (unsigned long)volume[i]);
+}
+
+// Day-number conversions after H. Hinnant's civil calendar algorithms
+bool OhlcvSeries::parseDay(std::string_view text, std::int32_t& out) {
+    if (text.size() < 10 || text[4] != '-' || text[7] != '-') return false;
+    int digits[8], k = 0;
+    for (int i : {0, 1, 2, 3, 5, 6, 8, 9}) {
+        if (text[i] < '0' || text[i] > '9') return false;
+        digits[k++] = text[i] - '0';
+    }
+    int y = digits[0] * 1000 + digits[1] * 100 + digits[2] * 10 + digits[3];
+    int m = digits[4] * 10 + digits[5];
+    int d = digits[6] * 10 + digits[7];
+    static const int kMonthDays[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    bool leap = y % 4 == 0 && (y % 100 != 0 || y % 400 == 0);
+    if (m < 1 || m > 12 || d < 1 || d > kMonthDays[m - 1] + (m == 2 && leap)) return false;
+    out = days(y, m, d);
+    return true;
+}
+
+std::int32_t OhlcvSeries::days(int y, int m, int d) {
+    y -= m <= 2;
+    int era = (y >= 0 ? y : y - 399) / 400;
+    int yoe = y - era * 400;
+    int doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + doe - 719468;
+}
+
+void OhlcvSeries::civil(std::int32_t z, int& y, int& m, int& d) {
+    z += 719468;
+    int era = (z >= 0 ? z : z - 146096) / 146097;
+    int doe = z - era * 146097;
+    int yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    int doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    int mp = (5 * doy + 2) / 153;
+    d = doy - (153 * mp + 2) / 5 + 1;
+    m = mp < 10 ? mp + 3 : mp - 9;
+    y = yoe + era * 400 + (m <= 2);
+}
+
+std::string OhlcvSeries::formatDay(std::int32_t z) {
+    int y, m, d;
+    civil(z, y, m, d);
+    char buf[32];
+    std::snprintf(buf, sizeof buf, "%04d-%02d-%02d", y, m, d);
+    return buf;
+}
@@ -0,0 +1,43 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "StockEntry.h"
+
+// Price history of one ticker as a structure of arrays: one contiguous
+// column per field, so a scan over e.g. closes reads nothing but closes
+// (8 bytes per row instead of a whole StockEntry with its date string).
+// Dates are stored as day numbers (days since 1970-01-01).
+class OhlcvSeries {
+public:
+    std::string ticker;
+    std::vector<std::int32_t> day;
+    std::vector<double> open;
+    std::vector<double> high;
+    std::vector<double> low;
+    std::vector<double> close;
+    std::vector<std::uint64_t> volume;
+
+    std::size_t size() const { return day.size(); }
+
+    // Reserve every column for `rows` rows
+    void reserve(std::size_t rows);
+
+    void push_back(std::int32_t d, double o, double h, double l, double c, std::uint64_t v);
+
+    // Add all rows of `other` at the end
+    void append(const OhlcvSeries& other);
+
+    // Row `i` as a StockEntry (for printing and older code)
+    StockEntry entry(std::size_t i) const;
+
+    // YYYY-MM-DD <-> day number; parseDay returns false for other text and
+    // for dates that do not exist (2021-02-29, 2020-04-31)
+    static bool parseDay(std::string_view text, std::int32_t& out);
+    static std::string formatDay(std::int32_t d);
+    // Year, month (1-12) and day of month <-> day number
+    static std::int32_t days(int year, int month, int dayOfMonth);
+    static void civil(std::int32_t d, int& year, int& month, int& dayOfMonth);
+};
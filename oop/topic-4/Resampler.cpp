@@ -0,0 +1,95 @@
+#include "Resampler.h"
+#include <cctype>                                // For isdigit
+#include <charconv>                              // For from_chars
+#include <stdexcept>
+
+namespace {
+// Largest bar count; keeps the bucket arithmetic well inside int32
+const int kMaxCount = 10000;
+
+// Division rounding towards minus infinity (days before 1970 are negative)
+std::int32_t floorDiv(std::int32_t a, std::int32_t b) {
+    return a / b - (a % b != 0 && (a < 0) != (b < 0));
+}
+}
+
+BarSize BarSize::parse(const std::string& text) {
+    std::size_t i = 0;
+    while (i < text.size() && std::isdigit((unsigned char)text[i])) ++i;
+    BarSize size;
+    if (i) {                                   // from_chars: no exceptions, no sign
+        auto res = std::from_chars(text.data(), text.data() + i, size.count);
+        if (res.ec != std::errc() || size.count > kMaxCount)
+            throw std::invalid_argument("Bar size count out of range in " + text);
+    }
+    std::string unit = text.substr(i);
+    if (unit == "day") size.unit = kDay;
+    else if (unit == "week") size.unit = kWeek;
+    else if (unit == "month") size.unit = kMonth;
+    else if (unit == "quarter") size.unit = kQuarter;
+    else if (unit == "year") size.unit = kYear;
+    else throw std::invalid_argument("Unknown bar size " + text);
+    if (size.count < 1) throw std::invalid_argument("Unknown bar size " + text);
+    return size;
+}
+
+Resampler::Resampler(BarSize size, OhlcvSeries& out) : size(size), out(out) {}
+
+void Resampler::add(std::int32_t day, double o, double h, double l, double c, std::uint64_t v) {
+    if (inBar && day < last) throw std::invalid_argument("Rows are not in date order");
+    if (!inBar || day >= end) {
+        finish();
+        startBucket(day);
+        inBar = true;
+        first = day;
+        open = o;
+        high = h;
+        low = l;
+        volume = 0;
+    }
+    if (h > high) high = h;
+    if (l < low) low = l;
+    close = c;
+    volume += v;
+    last = day;
+}
+
+void Resampler::finish() {
+    if (!inBar) return;
+    out.push_back(first, open, high, low, close, volume);
+    inBar = false;
+}
+
+void Resampler::startBucket(std::int32_t day) {
+    // Only done once per bar: later rows just compare against `end`
+    if (size.unit == BarSize::kDay) {
+        end = (floorDiv(day, size.count) + 1) * size.count;
+    } else if (size.unit == BarSize::kWeek) {
+        std::int32_t week = floorDiv(day + 3, 7);          // Week 0 starts Monday 1969-12-29
+        end = (floorDiv(week, size.count) + 1) * size.count * 7 - 3;
+    } else {
+        int months = size.count * (size.unit == BarSize::kMonth ? 1 : size.unit == BarSize::kQuarter ? 3 : 12);
+        int y, m, d;
+        OhlcvSeries::civil(day, y, m, d);
+        std::int32_t next = (floorDiv(y * 12 + m - 1, months) + 1) * months;
+        end = OhlcvSeries::days(floorDiv(next, 12), next - floorDiv(next, 12) * 12 + 1, 1);
+    }
+}
+
+OhlcvSeries Resampler::resample(const OhlcvSeries& daily, BarSize size) {
+    OhlcvSeries bars;
+    bars.ticker = daily.ticker;
+    Resampler r(size, bars);
+    for (std::size_t i = 0; i < daily.size(); ++i)
+        r.add(daily.day[i], daily.open[i], daily.high[i], daily.low[i], daily.close[i],
+              daily.volume[i]);
+    r.finish();
+    return bars;
+}
+
+std::vector<OhlcvSeries> Resampler::resample(const std::vector<OhlcvSeries>& daily, BarSize size,
+                                             WorkStealingPool& pool) {
+    std::vector<OhlcvSeries> bars(daily.size());
+    pool.run(daily.size(), [&](std::size_t i) { bars[i] = resample(daily[i], size); });
+    return bars;
+}
@@ -0,0 +1,54 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "OhlcvSeries.h"
+#include "WorkStealingPool.h"
+
+// Length of a resampled bar: `count` calendar units. Weeks start on
+// Monday; months, quarters and years on the 1st of the month.
+struct BarSize {
+    enum Unit { kDay, kWeek, kMonth, kQuarter, kYear };
+    Unit unit = kWeek;
+    int count = 1;                             // e.g. {kWeek, 2} for fortnightly bars
+
+    // "week", "month", "quarter", "year", "day", optionally with a count in
+    // front ("2week", "6month", at most 10000); throws std::invalid_argument
+    // otherwise
+    static BarSize parse(const std::string& text);
+};
+
+// Rolls daily rows up into longer bars in one pass: first open, highest
+// high, lowest low, last close and summed volume of the trading days in
+// each calendar bucket. Days without trading (weekends, holidays) simply
+// are not there, and buckets without any trading day produce no bar. A
+// bar is dated by its first trading day.
+class Resampler {
+public:
+    // Append the finished bars to `out`
+    Resampler(BarSize size, OhlcvSeries& out);
+
+    // Next daily row; days must not go backwards (std::invalid_argument)
+    void add(std::int32_t day, double open, double high, double low, double close,
+             std::uint64_t volume);
+
+    // Emit the bar in progress; call once after the last row
+    void finish();
+
+    static OhlcvSeries resample(const OhlcvSeries& daily, BarSize size);
+
+    // Every series on the pool; results are in input order
+    static std::vector<OhlcvSeries> resample(const std::vector<OhlcvSeries>& daily, BarSize size,
+                                             WorkStealingPool& pool);
+
+private:
+    void startBucket(std::int32_t day);        // Set `end` for the bucket of `day`
+
+    BarSize size;
+    OhlcvSeries& out;
+    bool inBar = false;
+    std::int32_t end = 0;                      // First day after the current bucket
+    std::int32_t first = 0, last = 0;          // Trading days seen in it
+    double open = 0, high = 0, low = 0, close = 0;
+    std::uint64_t volume = 0;
+};
@@ -0,0 +1,165 @@
+#include "SeriesPrinter.h"
+#include <stdexcept>
+#include <string_view>
+
+namespace {
+const int kTablePrecision = 6;                   // std::ostream's default
+
+struct ColumnName {
+    SeriesPrinter::Column column;
+    std::string_view name;                     // In CSV headers, JSON and --columns
+    std::string_view label;                    // In the table
+};
+
+const ColumnName kColumns[] = {
+    {SeriesPrinter::Column::kTicker, "ticker", "Ticker"},
+    {SeriesPrinter::Column::kDate,   "date",   "Date"},
+    {SeriesPrinter::Column::kClose,  "close",  "Close"},
+    {SeriesPrinter::Column::kHigh,   "high",   "High"},
+    {SeriesPrinter::Column::kLow,    "low",    "Low"},
+    {SeriesPrinter::Column::kOpen,   "open",   "Open"},
+    {SeriesPrinter::Column::kVolume, "volume", "Volume"},
+};
+
+const ColumnName& nameOf(SeriesPrinter::Column c) {
+    return kColumns[(int)c];
+}
+}
+
+std::vector<SeriesPrinter::Column> SeriesPrinter::defaultColumns() {
+    return {Column::kDate, Column::kClose, Column::kHigh, Column::kLow, Column::kOpen,
+            Column::kVolume};
+}
+
+SeriesPrinter::Format SeriesPrinter::parseFormat(const std::string& text) {
+    if (text == "table") return Format::kTable;
+    if (text == "csv") return Format::kCsv;
+    if (text == "ndjson") return Format::kNdjson;
+    throw std::invalid_argument("Unknown format " + text);
+}
+
+std::vector<SeriesPrinter::Column> SeriesPrinter::parseColumns(const std::string& list) {
+    std::vector<Column> columns;
+    std::size_t start = 0;
+    while (start <= list.size()) {
+        std::size_t comma = list.find(',', start);
+        if (comma == std::string::npos) comma = list.size();
+        std::string name = list.substr(start, comma - start);
+        bool found = false;
+        for (const ColumnName& c : kColumns)
+            if (name == c.name) {
+                columns.push_back(c.column);
+                found = true;
+            }
+        if (!found) throw std::invalid_argument("Unknown column " + name);
+        start = comma + 1;
+    }
+    return columns;
+}
+
+SeriesPrinter::SeriesPrinter(BufferedWriter& out, Format format, std::vector<Column> columns)
+    : out(out), format(format), columns(std::move(columns)) {}
+
+void SeriesPrinter::print(const std::vector<OhlcvSeries>& series) {
+    if (format == Format::kCsv) {
+        for (std::size_t k = 0; k < columns.size(); ++k) {
+            if (k) out.put(',');
+            out.put(nameOf(columns[k]).name);
+        }
+        out.put('\n');
+    }
+    for (const OhlcvSeries& s : series) {
+        if (format == Format::kTable) {
+            if (series.size() > 1) {
+                out.put("Ticker: ");
+                out.put(s.ticker);
+                out.put('\n');
+            }
+            printTable(s);
+        } else if (format == Format::kCsv) {
+            printCsv(s);
+        } else {
+            printNdjson(s);
+        }
+    }
+    out.flush();
+}
+
+void SeriesPrinter::printTable(const OhlcvSeries& s) {
+    out.put("Parsed ");
+    out.number((unsigned long long)s.size());
+    out.put(" valid entries.\n");
+    for (std::size_t i = 0; i < s.size(); ++i) {
+        for (std::size_t k = 0; k < columns.size(); ++k) {
+            if (k) out.put(" | ");
+            if (columns[k] != Column::kDate) {  // The date goes in unlabelled
+                out.put(nameOf(columns[k]).label);
+                out.put(": ");
+            }
+            value(s, columns[k], i, false);
+        }
+        out.put('\n');
+    }
+}
+
+void SeriesPrinter::printCsv(const OhlcvSeries& s) {
+    for (std::size_t i = 0; i < s.size(); ++i) {
+        for (std::size_t k = 0; k < columns.size(); ++k) {
+            if (k) out.put(',');
+            value(s, columns[k], i, true);
+        }
+        out.put('\n');
+    }
+}
+
+void SeriesPrinter::printNdjson(const OhlcvSeries& s) {
+    for (std::size_t i = 0; i < s.size(); ++i) {
+        out.put('{');
+        for (std::size_t k = 0; k < columns.size(); ++k) {
+            if (k) out.put(',');
+            out.put('"');
+            out.put(nameOf(columns[k]).name);
+            out.put("\":");
+            if (columns[k] == Column::kTicker) jsonString(s.ticker);
+            else if (columns[k] == Column::kDate) {
+                out.put('"');
+                date(s.day[i]);
+                out.put('"');
+            } else value(s, columns[k], i, true);
+        }
+        out.put("}\n");
+    }
+}
+
+void SeriesPrinter::value(const OhlcvSeries& s, Column c, std::size_t i, bool exact) {
+    switch (c) {
+    case Column::kTicker: out.put(s.ticker); break;
+    case Column::kDate:   date(s.day[i]); break;
+    case Column::kVolume: out.number((unsigned long long)s.volume[i]); break;
+    default: {
+        double v = c == Column::kClose ? s.close[i] : c == Column::kHigh ? s.high[i]
+                 : c == Column::kLow ? s.low[i] : s.open[i];
+        if (exact) out.number(v);
+        else out.number(v, kTablePrecision);
+    }
+    }
+}
+
+void SeriesPrinter::date(std::int32_t day) {
+    int y, m, d;
+    OhlcvSeries::civil(day, y, m, d);
+    char text[10] = {char('0' + y / 1000 % 10), char('0' + y / 100 % 10), char('0' + y / 10 % 10),
+                     char('0' + y % 10), '-', char('0' + m / 10), char('0' + m % 10), '-',
+                     char('0' + d / 10), char('0' + d % 10)};
+    out.put(text, sizeof text);
+}
+
+void SeriesPrinter::jsonString(const std::string& text) {
+    out.put('"');
+    for (char c : text) {
+        if (c == '"' || c == '\\') out.put('\\');
+        if ((unsigned char)c < 0x20) continue;  // Control characters are dropped
+        out.put(c);
+    }
+    out.put('"');
+}
@@ -0,0 +1,44 @@
+#pragma once
+#include <string>
+#include <vector>
+#include "BufferedWriter.h"
+#include "OhlcvSeries.h"
+
+// Writes price series through a BufferedWriter in one of three formats:
+//   table   the parser's original text ("Parsed N valid entries." and
+//           "2020-06-04 | Close: 70.3785 | ..."), 6 significant digits
+//   csv     a header line, then one line per row, numbers round-trip exact
+//   ndjson  one JSON object per row, numbers round-trip exact
+// Columns can be projected and reordered; the ticker is a column too.
+class SeriesPrinter {
+public:
+    enum class Format { kTable, kCsv, kNdjson };
+    enum class Column { kTicker, kDate, kClose, kHigh, kLow, kOpen, kVolume };
+
+    // Date, close, high, low, open, volume: the table's original columns
+    static std::vector<Column> defaultColumns();
+
+    // "table", "csv", "ndjson"; a comma-separated list of column names
+    // ("date,close,volume"). Both throw std::invalid_argument.
+    static Format parseFormat(const std::string& text);
+    static std::vector<Column> parseColumns(const std::string& list);
+
+    SeriesPrinter(BufferedWriter& out, Format format,
+                  std::vector<Column> columns = defaultColumns());
+
+    // All series; in the table format a "Ticker: X" line comes before each
+    // one when there are several
+    void print(const std::vector<OhlcvSeries>& series);
+
+private:
+    void printTable(const OhlcvSeries& s);
+    void printCsv(const OhlcvSeries& s);
+    void printNdjson(const OhlcvSeries& s);
+    void date(std::int32_t day);               // YYYY-MM-DD
+    void value(const OhlcvSeries& s, Column c, std::size_t i, bool exact);
+    void jsonString(const std::string& text);
+
+    BufferedWriter& out;
+    Format format;
+    std::vector<Column> columns;
+};
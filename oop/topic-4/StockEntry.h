@@ -4,12 +4,13 @@
 class StockEntry {
 public:
     std::string date;
-    double close;
-    double high;
-    double low;
-    double open;
-    unsigned long volume;
+    double close = 0;
+    double high = 0;
+    double low = 0;
+    double open = 0;
+    unsigned long volume = 0;
 
+    StockEntry() = default;
     StockEntry(std::string date, double close, double high, double low, double open, unsigned long volume)
         : date(date), close(close), high(high), low(low), open(open), volume(volume) {}
 };
@@ -0,0 +1,248 @@
+#include "StockLoader.h"
+#include <array>
+#include <cmath>                                 // For isnan
+#include <filesystem>                            // For file_size
+#include <ostream>
+#include <stdexcept>
+#include <thread>                                // Row chunks in parallel
+#include "CsvReader.h"
+
+namespace {
+// Cells of a record as they appear in "Invalid line" reports
+std::string cellsOf(const csv::Reader& reader) {
+    std::string text;
+    for (std::size_t i = 0; i < reader.size(); ++i) {
+        text += i ? ',' : ' ';
+        text += reader[i];
+    }
+    return text;
+}
+
+// Report a row that does not have one cell per header column
+void reportWidth(std::ostream* errors, std::size_t lineNumber, const std::string& cells) {
+    if (errors) *errors << "Invalid line " << lineNumber << ":" << cells << std::endl;
+}
+
+void reportParse(std::ostream* errors, std::size_t lineNumber) {
+    if (errors) *errors << "Error parsing line " << lineNumber << std::endl;
+}
+
+const std::size_t kMinChunk = 1 << 20;          // Smaller files are not split further
+
+// Where each ticker's fields are in a wide file
+enum Field { kOpen, kHigh, kLow, kClose, kVolume, kFields };
+const char* const kFieldNames[kFields] = {"Open", "High", "Low", "Close", "Volume"};
+
+struct WideLayout {
+    std::size_t width = 0;
+    int date = -1;
+    std::vector<std::string> tickers;
+    std::vector<std::array<int, kFields>> cells; // Per ticker, by Field
+};
+
+WideLayout layoutOf(const csv::Header& header) {
+    WideLayout w;
+    w.width = header.width();
+    w.date = header.find("Date");
+    if (w.date < 0) throw std::runtime_error("Missing column Date");
+    const std::vector<std::string>& fields = header.rows[0];
+    for (std::size_t c = 0; c < fields.size(); ++c) {
+        int f = 0;
+        while (f < kFields && fields[c] != kFieldNames[f]) ++f;
+        if ((int)c == w.date || f == kFields) continue; // "Adj Close" and the like
+        std::string ticker;
+        if (header.rows.size() > 1 && c < header.rows[1].size()) ticker = header.rows[1][c];
+        std::size_t t = 0;
+        while (t < w.tickers.size() && w.tickers[t] != ticker) ++t;
+        if (t == w.tickers.size()) {
+            w.tickers.push_back(ticker);
+            w.cells.push_back({-1, -1, -1, -1, -1});
+        }
+        if (w.cells[t][f] < 0) w.cells[t][f] = (int)c;
+    }
+    for (std::size_t t = 0; t < w.tickers.size(); ++t)
+        for (int f = 0; f < kFields; ++f)
+            if (w.cells[t][f] < 0)
+                throw std::runtime_error("Missing column " + std::string(kFieldNames[f])
+                                         + (w.tickers[t].empty() ? "" : " for " + w.tickers[t]));
+    return w;
+}
+
+// What one thread parsed from its byte range of a wide file
+struct WideChunk {
+    std::vector<OhlcvSeries> series;           // Per ticker
+    std::size_t records = 0;                   // For file-wide line numbers
+    struct Problem {
+        std::size_t line;                      // Within the chunk, 1-based
+        bool width;                            // Wrong cell count, else a bad cell
+        std::string cells;                     // The record, for width errors
+    };
+    std::vector<Problem> problems;
+};
+
+void parseChunk(const std::string& path, std::uint64_t from, std::uint64_t to,
+                const WideLayout& layout, std::size_t reserveRows, WideChunk& chunk) {
+    csv::Reader reader(path, from, to);
+    chunk.series.resize(layout.tickers.size());
+    for (auto& s : chunk.series) s.reserve(reserveRows);
+    std::int32_t day;
+    double open, high, low, close;
+    std::uint64_t volume;
+    while (reader.next()) {
+        std::size_t line = ++chunk.records;
+        if (reader.size() != layout.width) {
+            chunk.problems.push_back({line, true, cellsOf(reader)});
+            continue;
+        }
+        if (!OhlcvSeries::parseDay(reader[layout.date], day)) {
+            chunk.problems.push_back({line, false, std::string()});
+            continue;
+        }
+        bool bad = false;
+        for (std::size_t t = 0; t < layout.cells.size(); ++t) {
+            const std::array<int, kFields>& c = layout.cells[t];
+            std::string_view closeCell = reader[c[kClose]];
+            if (!csv::parse(closeCell, close)) {
+                // A blank close means the ticker is not listed that day
+                if (closeCell.find_first_not_of(" \t") != std::string_view::npos) bad = true;
+                continue;
+            }
+            if (std::isnan(close)) continue;   // So does an explicit NaN
+            if (csv::parse(reader[c[kOpen]], open) && csv::parse(reader[c[kHigh]], high)
+                && csv::parse(reader[c[kLow]], low) && csv::parse(reader[c[kVolume]], volume))
+                chunk.series[t].push_back(day, open, high, low, close, volume);
+            else
+                bad = true;
+        }
+        if (bad) chunk.problems.push_back({line, false, std::string()});
+    }
+}
+}
+
+std::vector<StockEntry> StockLoader::load(const std::string& path, std::ostream* errors) {
+    csv::Reader reader(path);
+    // readHeader(0) also takes the ",GOOGL,GOOGL,..." ticker row as header
+    csv::Header header = reader.readHeader(0);
+    auto columns = csv::mapping(csv::column("Date", &StockEntry::date),
+                                csv::column("Close", &StockEntry::close),
+                                csv::column("High", &StockEntry::high),
+                                csv::column("Low", &StockEntry::low),
+                                csv::column("Open", &StockEntry::open),
+                                csv::column("Volume", &StockEntry::volume));
+    columns.bind(header);
+
+    std::vector<StockEntry> entries;
+    StockEntry entry;
+    int lineNumber = 0;
+    while (reader.next()) {
+        lineNumber++;
+        if (reader.size() != header.width()) {
+            reportWidth(errors, lineNumber, cellsOf(reader));
+            continue;
+        }
+        if (!columns.read(reader, entry)) {
+            reportParse(errors, lineNumber);
+            continue;
+        }
+        entries.push_back(entry);
+    }
+    return entries;
+}
+
+OhlcvSeries StockLoader::loadSeries(const std::string& path, std::ostream* errors) {
+    // A row as it is parsed; the date stays a view into the read buffer
+    struct Row {
+        std::string_view date;
+        double close, high, low, open;
+        std::uint64_t volume;
+    };
+    csv::Reader reader(path);
+    csv::Header header = reader.readHeader(0);
+    auto columns = csv::mapping(csv::column("Date", &Row::date),
+                                csv::column("Close", &Row::close),
+                                csv::column("High", &Row::high),
+                                csv::column("Low", &Row::low),
+                                csv::column("Open", &Row::open),
+                                csv::column("Volume", &Row::volume));
+    columns.bind(header);
+
+    OhlcvSeries series;
+    if (header.rows.size() > 1 && header.width() > 1) series.ticker = header.rows[1][1];
+    series.reserve(csv::estimateRows(path));
+    Row row;
+    std::int32_t day;
+    int lineNumber = 0;
+    while (reader.next()) {
+        lineNumber++;
+        if (reader.size() != header.width()) {
+            reportWidth(errors, lineNumber, cellsOf(reader));
+            continue;
+        }
+        if (!columns.read(reader, row) || !OhlcvSeries::parseDay(row.date, day)) {
+            reportParse(errors, lineNumber);
+            continue;
+        }
+        series.push_back(day, row.open, row.high, row.low, row.close, row.volume);
+    }
+    return series;
+}
+
+std::vector<OhlcvSeries> StockLoader::loadWide(const std::string& path, std::ostream* errors,
+                                               unsigned threads) {
+    std::uint64_t dataStart;
+    WideLayout layout;
+    {
+        csv::Reader reader(path);
+        layout = layoutOf(reader.readHeader(0));
+        dataStart = reader.position();
+    }
+
+    // One chunk per thread, but none much under kMinChunk bytes
+    if (threads == 0) threads = std::thread::hardware_concurrency();
+    std::uint64_t bytes = std::filesystem::file_size(path) - dataStart;
+    std::size_t parts = threads ? threads : 1;
+    if (parts > bytes / kMinChunk) parts = bytes / kMinChunk ? bytes / kMinChunk : 1;
+    std::vector<std::uint64_t> cuts = csv::splitLines(path, dataStart, parts);
+    std::size_t rows = csv::estimateRows(path);
+
+    std::vector<WideChunk> chunks(parts);
+    std::vector<std::string> failures(parts);
+    auto work = [&](std::size_t i) {
+        try {
+            std::size_t share = bytes ? (std::size_t)((double)rows * (cuts[i + 1] - cuts[i]) / bytes) : 0;
+            parseChunk(path, cuts[i], cuts[i + 1], layout, share, chunks[i]);
+        } catch (const std::exception& e) {
+            failures[i] = e.what();            // Rethrown on the calling thread
+        }
+    };
+    std::vector<std::thread> pool;
+    for (std::size_t i = 1; i < parts; ++i) pool.emplace_back(work, i);
+    work(0);
+    for (auto& t : pool) t.join();
+    for (auto& f : failures)
+        if (!f.empty()) throw std::runtime_error(f);
+
+    // Join the chunks in file order; line numbers continue across chunks
+    std::vector<OhlcvSeries> series(layout.tickers.size());
+    for (std::size_t t = 0; t < series.size(); ++t) {
+        if (parts == 1) {
+            series[t] = std::move(chunks[0].series[t]);
+            series[t].ticker = layout.tickers[t];
+            continue;
+        }
+        series[t].ticker = layout.tickers[t];
+        std::size_t total = 0;
+        for (auto& c : chunks) total += c.series[t].size();
+        series[t].reserve(total);
+        for (auto& c : chunks) series[t].append(c.series[t]);
+    }
+    std::size_t firstLine = 0;
+    for (auto& c : chunks) {
+        for (auto& p : c.problems) {
+            if (p.width) reportWidth(errors, firstLine + p.line, p.cells);
+            else reportParse(errors, firstLine + p.line);
+        }
+        firstLine += c.records;
+    }
+    return series;
+}
@@ -0,0 +1,30 @@
+#pragma once
+#include <iosfwd>
+#include <string>
+#include <vector>
+#include "OhlcvSeries.h"
+#include "StockEntry.h"
+
+class StockLoader {
+public:
+    // Load a yfinance-style price CSV (field header row, optional ticker
+    // row). Rows with the wrong width or unparsable numbers are reported to
+    // `errors` (if given) and skipped. Throws std::runtime_error if the file
+    // cannot be opened.
+    static std::vector<StockEntry> load(const std::string& path, std::ostream* errors);
+
+    // Same rules, straight into columns pre-sized from the file size; rows
+    // whose date is not YYYY-MM-DD are skipped too
+    static OhlcvSeries loadSeries(const std::string& path, std::ostream* errors);
+
+    // Load a wide export holding several tickers: a field row (Date/Price,
+    // Close,High,...) over a ticker row, one column per ticker x field.
+    // Returns one series per ticker, in header order. The rows are cut
+    // into chunks parsed on `threads` threads (0 = one per core) and the
+    // chunks are joined in file order. A ticker whose cells in a row are
+    // all empty (not yet listed) just has no entry for that day; other
+    // bad rows are reported as by loadSeries. Throws std::runtime_error if
+    // the file cannot be opened or a ticker lacks one of the fields.
+    static std::vector<OhlcvSeries> loadWide(const std::string& path, std::ostream* errors,
+                                             unsigned threads = 0);
+};
@@ -0,0 +1,35 @@
+#include "Strategies.h"
+#include <cmath>                                 // For isnan
+
+void SmaCross::onBar(const OhlcvSeries&, std::size_t i, Broker& broker) {
+    if (std::isnan(fast[i]) || std::isnan(slow[i])) return; // Still warming up
+    bool want = fast[i] > slow[i];
+    if (want && broker.position() == 0) broker.buyAll();
+    else if (!want && broker.position() != 0) broker.target(0);
+}
+
+std::vector<IndicatorSpec> SmaCross::Factory::indicators(const std::vector<int>& p) const {
+    return {{IndicatorSpec::kSma, p.at(0)}, {IndicatorSpec::kSma, p.at(1)}};
+}
+
+std::unique_ptr<Strategy> SmaCross::Factory::make(const std::vector<int>& p,
+                                                  const IndicatorCache& cache) const {
+    return std::make_unique<SmaCross>(cache.get({IndicatorSpec::kSma, p.at(0)}),
+                                      cache.get({IndicatorSpec::kSma, p.at(1)}));
+}
+
+void RsiReversion::onBar(const OhlcvSeries&, std::size_t i, Broker& broker) {
+    if (std::isnan(rsi[i])) return;            // Still warming up
+    if (rsi[i] < low && broker.position() == 0) broker.buyAll();
+    else if (rsi[i] > high && broker.position() != 0) broker.target(0);
+}
+
+std::vector<IndicatorSpec> RsiReversion::Factory::indicators(const std::vector<int>& p) const {
+    return {{IndicatorSpec::kRsi, p.at(0)}};
+}
+
+std::unique_ptr<Strategy> RsiReversion::Factory::make(const std::vector<int>& p,
+                                                      const IndicatorCache& cache) const {
+    return std::make_unique<RsiReversion>(cache.get({IndicatorSpec::kRsi, p.at(0)}),
+                                          p.at(1), p.at(2));
+}
@@ -0,0 +1,44 @@
+#pragma once
+#include <memory>
+#include <vector>
+#include "Backtester.h"
+
+// Long while the fast SMA of closes is above the slow one, flat otherwise.
+// Params: {fast, slow}.
+class SmaCross : public Strategy {
+public:
+    SmaCross(const std::vector<double>& fast, const std::vector<double>& slow)
+        : fast(fast), slow(slow) {}
+    void onBar(const OhlcvSeries& series, std::size_t i, Broker& broker) override;
+
+    class Factory : public StrategyFactory {
+    public:
+        std::vector<IndicatorSpec> indicators(const std::vector<int>& params) const override;
+        std::unique_ptr<Strategy> make(const std::vector<int>& params,
+                                       const IndicatorCache& cache) const override;
+    };
+
+private:
+    const std::vector<double>& fast;
+    const std::vector<double>& slow;
+};
+
+// Buys when the RSI drops below `low` and sells when it rises above
+// `high`. Params: {period, low, high}.
+class RsiReversion : public Strategy {
+public:
+    RsiReversion(const std::vector<double>& rsi, int low, int high)
+        : rsi(rsi), low(low), high(high) {}
+    void onBar(const OhlcvSeries& series, std::size_t i, Broker& broker) override;
+
+    class Factory : public StrategyFactory {
+    public:
+        std::vector<IndicatorSpec> indicators(const std::vector<int>& params) const override;
+        std::unique_ptr<Strategy> make(const std::vector<int>& params,
+                                       const IndicatorCache& cache) const override;
+    };
+
+private:
+    const std::vector<double>& rsi;
+    int low, high;
+};
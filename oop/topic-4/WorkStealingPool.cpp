@@ -0,0 +1,99 @@
+#include "WorkStealingPool.h"
+
+WorkStealingPool::WorkStealingPool(unsigned threads) {
+    if (threads == 0) threads = std::thread::hardware_concurrency();
+    if (threads == 0) threads = 1;
+    for (unsigned i = 0; i < threads; ++i) queues.push_back(std::make_unique<Queue>());
+    for (unsigned i = 1; i < threads; ++i) workers.emplace_back(&WorkStealingPool::workerLoop, this, i);
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& t : workers) t.join();
+}
+
+void WorkStealingPool::run(std::size_t count, const std::function<void(std::size_t)>& task) {
+    if (count == 0) return;
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        job = &task;
+        remaining = count;
+        error = nullptr;
+    }
+    // Deal the tasks out in contiguous blocks, one per queue
+    std::size_t n = queues.size();
+    for (std::size_t q = 0; q < n; ++q) {
+        std::lock_guard<std::mutex> guard(queues[q]->lock);
+        for (std::size_t i = count * q / n; i < count * (q + 1) / n; ++i)
+            queues[q]->items.push_back(i);
+    }
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        ++generation;
+    }
+    wake.notify_all();
+    drain(0);
+
+    std::unique_lock<std::mutex> guard(lock);
+    finished.wait(guard, [&] { return remaining == 0; });
+    job = nullptr;
+    if (error) std::rethrow_exception(error);
+}
+
+void WorkStealingPool::workerLoop(unsigned id) {
+    std::size_t seen = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            wake.wait(guard, [&] { return stopping || generation != seen; });
+            if (stopping) return;
+            seen = generation;
+        }
+        drain(id);
+    }
+}
+
+void WorkStealingPool::drain(unsigned id) {
+    std::size_t item;
+    while (take(id, item)) {
+        const std::function<void(std::size_t)>* task;
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            task = job;
+        }
+        try {
+            (*task)(item);
+        } catch (...) {
+            std::lock_guard<std::mutex> guard(lock);
+            if (!error) error = std::current_exception();
+        }
+        std::lock_guard<std::mutex> guard(lock);
+        if (--remaining == 0) finished.notify_all();
+    }
+}
+
+bool WorkStealingPool::take(unsigned id, std::size_t& item) {
+    {
+        Queue& own = *queues[id];
+        std::lock_guard<std::mutex> guard(own.lock);
+        if (!own.items.empty()) {
+            item = own.items.back();
+            own.items.pop_back();
+            return true;
+        }
+    }
+    for (std::size_t k = 1; k < queues.size(); ++k) {
+        Queue& victim = *queues[(id + k) % queues.size()];
+        std::lock_guard<std::mutex> guard(victim.lock);
+        if (!victim.items.empty()) {
+            item = victim.items.front();
+            victim.items.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
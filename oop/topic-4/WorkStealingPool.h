@@ -0,0 +1,50 @@
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads for batches of independent tasks. Each
+// worker has its own queue: it takes tasks from the back of its queue and,
+// once that is empty, steals from the front of the others', so uneven
+// task costs even out without a single contended queue. The calling
+// thread works on the batch too.
+class WorkStealingPool {
+public:
+    explicit WorkStealingPool(unsigned threads = 0);   // 0 = one per core
+    ~WorkStealingPool();
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    unsigned size() const { return (unsigned)queues.size(); }
+
+    // Run task(i) for every i in [0, count) and return when all are done.
+    // The first exception thrown by a task is rethrown here. One batch at
+    // a time: tasks must not call run themselves.
+    void run(std::size_t count, const std::function<void(std::size_t)>& task);
+
+private:
+    struct Queue {
+        std::mutex lock;
+        std::deque<std::size_t> items;
+    };
+
+    void workerLoop(unsigned id);
+    void drain(unsigned id);                   // Run tasks until none are left
+    bool take(unsigned id, std::size_t& item);
+
+    std::vector<std::unique_ptr<Queue>> queues; // One per worker, [0] is the caller's
+    std::vector<std::thread> workers;
+    std::mutex lock;                           // Guards the fields below
+    std::condition_variable wake, finished;
+    const std::function<void(std::size_t)>* job = nullptr;
+    std::size_t generation = 0;                // Batches started so far
+    std::size_t remaining = 0;                 // Tasks of the batch not yet done
+    bool stopping = false;
+    std::exception_ptr error;
+};
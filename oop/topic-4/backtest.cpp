@@ -0,0 +1,77 @@
+// Parameter sweeps of the sample strategies over one ticker's history.
+// Build: g++ -std=c++17 -O2 -pthread -I../common backtest.cpp Backtester.cpp Strategies.cpp Indicators.cpp WorkStealingPool.cpp StockLoader.cpp OhlcvSeries.cpp -o backtest
+// Usage: ./backtest [file.csv] [threads]
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "Backtester.h"
+#include "StockLoader.h"
+#include "Strategies.h"
+
+std::vector<int> range(int from, int to, int step) {
+    std::vector<int> values;
+    for (int v = from; v <= to; v += step) values.push_back(v);
+    return values;
+}
+
+// Sweep one strategy, print throughput and the best runs by Sharpe ratio
+void report(const char* name, const OhlcvSeries& series, std::vector<std::vector<int>> grid,
+            const StrategyFactory& factory, const BacktestConfig& config, WorkStealingPool& pool) {
+    auto start = std::chrono::steady_clock::now();
+    std::vector<SweepRun> runs = Backtester::sweep(series, grid, factory, config, pool);
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << name << ": " << runs.size() << " runs in " << secs << " s, "
+              << runs.size() / secs << " runs/s" << std::endl;
+    std::sort(runs.begin(), runs.end(), [](const SweepRun& a, const SweepRun& b) {
+        return a.result.sharpe > b.result.sharpe;
+    });
+    for (std::size_t i = 0; i < runs.size() && i < 5; ++i) {
+        const BacktestResult& r = runs[i].result;
+        std::cout << "  params";
+        for (int p : runs[i].params) std::cout << " " << p;
+        std::cout << std::fixed << std::setprecision(2)
+                  << " | P&L: " << r.pnl << " | Return: " << r.totalReturn * 100 << "%"
+                  << " | Max drawdown: " << r.maxDrawdown * 100 << "%"
+                  << " | Sharpe: " << r.sharpe << " | Trades: " << r.trades << std::endl;
+        std::cout << std::defaultfloat << std::setprecision(6);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    std::string path = argc > 1 ? argv[1] : "google_5yr_one.csv";
+    unsigned threads = argc > 2 ? (unsigned)std::stoi(argv[2]) : 0;
+    std::vector<OhlcvSeries> tickers;
+    try {
+        tickers = StockLoader::loadWide(path, &std::cerr);
+    } catch (const std::runtime_error& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    if (tickers.empty() || tickers[0].size() == 0) {
+        std::cerr << "No prices in " << path << std::endl;
+        return 1;
+    }
+    const OhlcvSeries& series = tickers[0];
+
+    BacktestConfig config;
+    config.fill = FillPrice::kNextOpen;
+    config.costs.rate = 0.0005;                // 5 bp commission, at least 1
+    config.costs.minimum = 1;
+    config.costs.slippage = 0.0005;
+    WorkStealingPool pool(threads);
+    std::cout << series.ticker << ", " << series.size() << " bars, "
+              << pool.size() << " threads" << std::endl;
+
+    std::vector<std::vector<int>> crosses;
+    for (auto& p : Backtester::grid({range(2, 60, 1), range(10, 300, 2)}))
+        if (p[0] < p[1]) crosses.push_back(p);
+    report("SMA cross", series, crosses, SmaCross::Factory(), config, pool);
+    report("RSI reversion", series,
+           Backtester::grid({range(2, 30, 1), range(10, 40, 5), range(60, 90, 5)}),
+           RsiReversion::Factory(), config, pool);
+    return 0;
+}
@@ -0,0 +1,96 @@
+// CSV loading benchmark: the original tokenise() + std::stod loop against
+// StockLoader (csv::Reader with a typed row mapping), into StockEntry
+// rows, into a columnar OhlcvSeries and through the chunked wide loader.
+// Build: g++ -std=c++17 -O2 -pthread -I../common csv_bench.cpp StockLoader.cpp OhlcvSeries.cpp -o csv_bench
+// Usage: ./csv_bench [file.csv] [repetitions]
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "OhlcvSeries.h"
+#include "StockEntry.h"
+#include "StockLoader.h"
+
+// The loader as it was before csv::Reader, kept for comparison
+std::vector<std::string> tokenise(const std::string& line, char delimiter) {
+    std::vector<std::string> tokens;
+    std::string token;
+    std::stringstream ss(line);
+    while (getline(ss, token, delimiter)) {
+        tokens.push_back(token);
+    }
+    return tokens;
+}
+
+std::vector<StockEntry> loadWithTokenise(const std::string& path) {
+    std::ifstream file(path);
+    std::string line;
+    std::vector<StockEntry> entries;
+    std::getline(file, line);
+    std::getline(file, line);
+    while (std::getline(file, line)) {
+        std::vector<std::string> tokens = tokenise(line, ',');
+        if (tokens.size() != 6) continue;
+        try {
+            entries.emplace_back(tokens[0], std::stod(tokens[1]), std::stod(tokens[2]),
+                                 std::stod(tokens[3]), std::stod(tokens[4]),
+                                 std::stoul(tokens[5]));
+        } catch (const std::exception&) {
+        }
+    }
+    return entries;
+}
+
+// Checksum over rows, so every loader's output is compared
+double checksum(const std::vector<StockEntry>& entries) {
+    double sum = 0;
+    for (const auto& e : entries) sum += e.close + e.volume;
+    return sum;
+}
+
+double checksum(const OhlcvSeries& s) {
+    double sum = 0;                            // Touches two columns only
+    for (std::size_t i = 0; i < s.size(); ++i) sum += s.close[i] + s.volume[i];
+    return sum;
+}
+
+// Run `load` `reps` times; print rows/s and MB/s and return the checksum
+template <class Load>
+double bench(const char* name, Load load, int reps, double megabytes) {
+    double sum = 0;
+    std::size_t rows = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < reps; ++r) {
+        auto loaded = load();
+        rows += loaded.size();
+        sum = checksum(loaded);
+    }
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << name << ": " << rows / secs / 1e6 << " M rows/s, "
+              << megabytes * reps / secs << " MB/s (" << secs << " s)" << std::endl;
+    return sum;
+}
+
+int main(int argc, char* argv[]) {
+    std::string path = argc > 1 ? argv[1] : "google_5yr_one.csv";
+    int reps = argc > 2 ? std::stoi(argv[2]) : 200;
+    std::ifstream size(path, std::ios::binary | std::ios::ate);
+    if (!size) {
+        std::cerr << "Failed to open file." << std::endl;
+        return 1;
+    }
+    double megabytes = size.tellg() / 1e6;
+
+    double a = bench("tokenise + stod   ", [&] { return loadWithTokenise(path); }, reps, megabytes);
+    double b = bench("csv -> StockEntry ", [&] { return StockLoader::load(path, nullptr); }, reps, megabytes);
+    double c = bench("csv -> OhlcvSeries", [&] { return StockLoader::loadSeries(path, nullptr); }, reps, megabytes);
+    double d = bench("csv -> loadWide   ", [&] { return std::move(StockLoader::loadWide(path, nullptr)[0]); },
+                     reps, megabytes);
+    if (a != b || a != c || a != d) {
+        std::cerr << "Loaders disagree" << std::endl;
+        return 1;
+    }
+    return 0;
+}
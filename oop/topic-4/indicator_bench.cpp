@@ -0,0 +1,114 @@
+// Indicator benchmark: 50 indicators over synthetic daily histories
+// (default 500 tickers x 20 years), checked against naive versions first.
+// Build: g++ -std=c++17 -O3 -pthread -I../common indicator_bench.cpp Indicators.cpp OhlcvSeries.cpp -o indicator_bench
+// Usage: ./indicator_bench [tickers] [years] [threads]
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <string>
+#include <vector>
+#include "Indicators.h"
+#include "OhlcvSeries.h"
+
+// Random-walk prices, one row per trading day
+OhlcvSeries synthetic(int id, std::size_t days) {
+    std::mt19937_64 rng(id);
+    std::normal_distribution<double> step(0.0003, 0.02);
+    std::uniform_real_distribution<double> range(0.0, 0.02);
+    OhlcvSeries s;
+    s.ticker = "T" + std::to_string(id);
+    s.reserve(days);
+    double price = 20 + id % 200;
+    for (std::size_t d = 0; d < days; ++d) {
+        double open = price;
+        price *= std::exp(step(rng));
+        double high = std::max(open, price) * (1 + range(rng));
+        double low = std::min(open, price) * (1 - range(rng));
+        s.push_back((std::int32_t)d, open, high, low, price, 1000000 + rng() % 5000000);
+    }
+    return s;
+}
+
+// Largest difference between two outputs (NaN must match NaN)
+double maxError(const std::vector<double>& a, const std::vector<double>& b) {
+    double worst = 0;
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        if (std::isnan(a[i]) != std::isnan(b[i])) return INFINITY;
+        if (!std::isnan(a[i])) worst = std::max(worst, std::fabs(a[i] - b[i]) / std::max(1.0, std::fabs(b[i])));
+    }
+    return worst;
+}
+
+// The O(n * period) definitions, for checking
+std::vector<double> naiveSma(const std::vector<double>& x, int p) {
+    std::vector<double> out(x.size(), NAN);
+    for (std::size_t i = p - 1; i < x.size(); ++i) {
+        double s = 0;
+        for (int k = 0; k < p; ++k) s += x[i - k];
+        out[i] = s / p;
+    }
+    return out;
+}
+
+std::vector<double> naiveVwap(const OhlcvSeries& s, int p) {
+    std::vector<double> out(s.size(), NAN);
+    for (std::size_t i = p - 1; i < s.size(); ++i) {
+        double pv = 0, v = 0;
+        for (int k = 0; k < p; ++k) {
+            std::size_t j = i - k;
+            pv += (s.high[j] + s.low[j] + s.close[j]) / 3 * s.volume[j];
+            v += s.volume[j];
+        }
+        out[i] = pv / v;
+    }
+    return out;
+}
+
+int main(int argc, char* argv[]) {
+    int tickers = argc > 1 ? std::stoi(argv[1]) : 500;
+    int years = argc > 2 ? std::stoi(argv[2]) : 20;
+    unsigned threads = argc > 3 ? (unsigned)std::stoi(argv[3]) : 0;
+    std::size_t days = (std::size_t)years * 252;
+
+    std::vector<OhlcvSeries> series;
+    for (int t = 0; t < tickers; ++t) series.push_back(synthetic(t, days));
+
+    std::vector<double> out;
+    double err = 0;
+    for (int p : {1, 5, 50}) {
+        Indicators::compute(series[0], {IndicatorSpec::kSma, p}, out);
+        err = std::max(err, maxError(out, naiveSma(series[0].close, p)));
+        Indicators::compute(series[0], {IndicatorSpec::kVwap, p}, out);
+        err = std::max(err, maxError(out, naiveVwap(series[0], p)));
+    }
+    std::cout << "Largest relative error against naive SMA/VWAP: " << err << std::endl;
+    if (!(err < 1e-9)) return 1;
+
+    // 20 SMAs, 15 EMAs, 5 RSIs, 3 MACDs x 3 outputs, 1 VWAP
+    std::vector<IndicatorSpec> specs;
+    for (int p = 5; p <= 100; p += 5) specs.push_back({IndicatorSpec::kSma, p});
+    for (int p = 8; p <= 200; p += 13) specs.push_back({IndicatorSpec::kEma, p});
+    for (int p : {7, 9, 14, 21, 28}) specs.push_back({IndicatorSpec::kRsi, p});
+    for (int fast : {8, 12, 19})
+        for (auto kind : {IndicatorSpec::kMacd, IndicatorSpec::kMacdSignal, IndicatorSpec::kMacdHistogram})
+            specs.push_back({kind, fast, fast * 2 + 2, 9});
+    specs.push_back({IndicatorSpec::kVwap, 20});
+
+    std::mutex lock;
+    double checksum = 0;
+    auto start = std::chrono::steady_clock::now();
+    Indicators::computeBatch(series, specs, [&](std::size_t, const std::vector<std::vector<double>>& values) {
+        double sum = 0;                        // Last value of each indicator
+        for (auto& v : values) sum += v.back();
+        std::lock_guard<std::mutex> guard(lock);
+        checksum += sum;
+    }, threads);
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    double values = (double)specs.size() * tickers * days;
+    std::cout << specs.size() << " indicators x " << tickers << " tickers x " << days << " days: "
+              << secs << " s, " << values / secs / 1e6 << " M values/s (checksum " << checksum << ")"
+              << std::endl;
+    return 0;
+}
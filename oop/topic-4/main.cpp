@@ -1,68 +1,62 @@
+// Build: g++ -std=c++17 -O2 -pthread -I../common main.cpp StockLoader.cpp OhlcvSeries.cpp Resampler.cpp WorkStealingPool.cpp SeriesPrinter.cpp -o parser
+// Usage: ./parser [file.csv] [week|month|quarter|year|<n>day...]
+//                 [--format table|csv|ndjson] [--columns date,close,...]
 #include <iostream>
-#include <fstream>
-#include <sstream>
-#include <vector>
+#include <stdexcept>
 #include <string>
-#include "StockEntry.h"
-
-std::vector<std::string> tokenise(const std::string& line, char delimiter) {
-    std::vector<std::string> tokens;
-    std::string token;
-    std::stringstream ss(line);
-    while (getline(ss, token, delimiter)) {
-        tokens.push_back(token);
+#include <vector>
+#include "BufferedWriter.h"
+#include "OhlcvSeries.h"
+#include "Resampler.h"
+#include "SeriesPrinter.h"
+#include "StockLoader.h"
+
+int main(int argc, char* argv[]) {
+    std::string path = "google_5yr_one.csv";
+    std::string barSize;
+    SeriesPrinter::Format format = SeriesPrinter::Format::kTable;
+    std::vector<SeriesPrinter::Column> columns = SeriesPrinter::defaultColumns();
+    try {
+        int positional = 0;
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            if ((arg == "--format" || arg == "--columns") && i + 1 < argc) {
+                std::string value = argv[++i];
+                if (arg == "--format") format = SeriesPrinter::parseFormat(value);
+                else columns = SeriesPrinter::parseColumns(value);
+            } else if (positional == 0 && arg.compare(0, 2, "--") != 0) {
+                path = arg;
+                positional++;
+            } else if (positional == 1 && arg.compare(0, 2, "--") != 0) {
+                barSize = arg;
+                positional++;
+            } else {
+                throw std::invalid_argument("Unexpected argument " + arg);
+            }
+        }
+    } catch (const std::invalid_argument& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
     }
-    return tokens;
-}
 
-int main() {
-    std::ifstream file("google_5yr_one.csv");
-    if (!file.is_open()) {
-        std::cerr << "Failed to open file." << std::endl;
+    std::vector<OhlcvSeries> tickers;
+    try {
+        tickers = StockLoader::loadWide(path, &std::cerr);
+    } catch (const std::runtime_error& e) {
+        std::cerr << e.what() << std::endl;
         return 1;
     }
-
-    std::string line;
-    std::vector<StockEntry> entries;
-    int lineNumber = 0;
-
-    // Skip the first two lines (header + GOOGL line)
-    std::getline(file, line);
-    std::getline(file, line);
-
-    while (std::getline(file, line)) {
-        lineNumber++;
-        std::vector<std::string> tokens = tokenise(line, ',');
-        if (tokens.size() != 6) {
-            std::cerr << "Invalid line " << lineNumber << ": " << line << std::endl;
-            continue;
-        }
-
+    if (!barSize.empty()) {
         try {
-            std::string date = tokens[0];
-            double close = std::stod(tokens[1]);
-            double high = std::stod(tokens[2]);
-            double low = std::stod(tokens[3]);
-            double open = std::stod(tokens[4]);
-            unsigned long volume = std::stoul(tokens[5]);
-
-            entries.emplace_back(date, close, high, low, open, volume);
-        } catch (const std::exception& e) {
-            std::cerr << "Error parsing line " << lineNumber << ": " << e.what() << std::endl;
-            continue;
+            WorkStealingPool pool;
+            tickers = Resampler::resample(tickers, BarSize::parse(barSize), pool);
+        } catch (const std::invalid_argument& e) {
+            std::cerr << e.what() << std::endl;
+            return 1;
         }
     }
 
-    file.close();
-
-    std::cout << "Parsed " << entries.size() << " valid entries." << std::endl;
-    for (const auto& entry : entries) {
-        std::cout << entry.date << " | Close: " << entry.close
-                  << " | High: " << entry.high
-                  << " | Low: " << entry.low
-                  << " | Open: " << entry.open
-                  << " | Volume: " << entry.volume << std::endl;
-    }
-
+    BufferedWriter out("-");
+    SeriesPrinter(out, format, columns).print(tickers);
     return 0;
 }
@@ -0,0 +1,57 @@
+// Output benchmark: the original ostream/std::endl printing loop against
+// SeriesPrinter in each format, over synthetic rows.
+// Build: g++ -std=c++17 -O2 -I../common print_bench.cpp SeriesPrinter.cpp OhlcvSeries.cpp -o print_bench
+// Usage: ./print_bench [rows] [output file]
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "BufferedWriter.h"
+#include "OhlcvSeries.h"
+#include "SeriesPrinter.h"
+
+template <class Print>
+void bench(const char* name, Print print, std::size_t rows) {
+    auto start = std::chrono::steady_clock::now();
+    print();
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << name << ": " << secs * 1000 << " ms, " << rows / secs / 1e6 << " M rows/s" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    std::size_t rows = argc > 1 ? std::stoul(argv[1]) : 1000000;
+    std::string path = argc > 2 ? argv[2] : "/dev/null";
+
+    std::vector<OhlcvSeries> series(1);
+    series[0].ticker = "SYN";
+    series[0].reserve(rows);
+    for (std::size_t i = 0; i < rows; ++i) {
+        // Prices wander between about 50 and 150, with ragged decimals
+        double price = 100 + 50 * std::sin(i * 1e-3) + (int)(i * 7919 % 201) * 1e-3 / 3;
+        series[0].push_back((std::int32_t)(i % 40000), price, price * 1.01, price * 0.99,
+                            price * 1.001, 1000000 + i % 777777);
+    }
+    const OhlcvSeries& s = series[0];
+
+    bench("ostream + endl", [&] {
+        std::ofstream out(path);
+        out << "Parsed " << s.size() << " valid entries." << std::endl;
+        for (std::size_t i = 0; i < s.size(); ++i)
+            out << OhlcvSeries::formatDay(s.day[i]) << " | Close: " << s.close[i]
+                << " | High: " << s.high[i] << " | Low: " << s.low[i]
+                << " | Open: " << s.open[i] << " | Volume: " << s.volume[i] << std::endl;
+    }, rows);
+    for (auto format : {SeriesPrinter::Format::kTable, SeriesPrinter::Format::kCsv,
+                        SeriesPrinter::Format::kNdjson}) {
+        const char* name = format == SeriesPrinter::Format::kTable ? "printer, table "
+                         : format == SeriesPrinter::Format::kCsv   ? "printer, csv   "
+                                                                   : "printer, ndjson";
+        bench(name, [&] {
+            BufferedWriter out(path);
+            SeriesPrinter(out, format).print(series);
+        }, rows);
+    }
+    return 0;
+}